@@ -0,0 +1,192 @@
+#ifndef _LY_BENCH_BENCH_H
+#define _LY_BENCH_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ly {
+namespace Bench {
+
+// Keeps a value alive so the optimizer cannot drop the work that produced it
+template <typename T>
+inline void keep(const T &x) {
+	asm volatile("" : : "r,m"(x) : "memory");
+}
+
+struct Timer {
+	std::chrono::steady_clock::time_point start;
+
+	Timer() : start(std::chrono::steady_clock::now()) {}
+
+	double elapsed() const {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+};
+
+// Seconds per repetition of one benchmark, `ops` is the work done in each
+struct Result {
+	std::string name;
+	double ops;
+	std::vector<double> samples;
+
+	// Nearest rank on the sorted samples, p in [0, 100]
+	double percentile(double p) const {
+		std::vector<double> s(samples);
+		std::sort(s.begin(), s.end());
+		size_t i = std::min(s.size() - 1, (size_t)(p / 100 * s.size()));
+		return s[i];
+	}
+
+	double throughput() const {
+		return ops / percentile(50);
+	}
+};
+
+// Command line: [--filter=substring] [--reps=N] [--save=file.json] [--compare=file.json] [--threshold=0.1]
+// A benchmark regresses when its median exceeds the baseline median by more than the threshold,
+// and the process then exits with status 1.
+struct Runner {
+	std::string filter, save, compare;
+	int reps;
+	double threshold;
+	std::vector<Result> results;
+
+	Runner(int argc, char **argv) : reps(10), threshold(0.1) {
+		for (int i = 1; i < argc; i++) {
+			std::string a = argv[i];
+			if (a.compare(0, 9, "--filter=") == 0) filter = a.substr(9);
+			else if (a.compare(0, 7, "--reps=") == 0) reps = std::max(1, atoi(a.c_str() + 7));
+			else if (a.compare(0, 7, "--save=") == 0) save = a.substr(7);
+			else if (a.compare(0, 10, "--compare=") == 0) compare = a.substr(10);
+			else if (a.compare(0, 12, "--threshold=") == 0) threshold = atof(a.c_str() + 12);
+			else {
+				fprintf(stderr, "unknown option %s\n", argv[i]);
+				exit(2);
+			}
+		}
+		printf("%-40s %12s %10s %10s %10s %10s %14s\n", "benchmark", "ops", "min ms", "p50 ms", "p90 ms", "p99 ms", "ops/s");
+	}
+
+	// `setup()` runs untimed before every repetition and `f()` is timed, one untimed warmup run comes first
+	template <typename S, typename F>
+	void run(const std::string &name, double ops, S setup, F f) {
+		if (name.find(filter) == std::string::npos) return;
+
+		Result r;
+		r.name = name;
+		r.ops = ops;
+
+		setup();
+		f();
+		for (int i = 0; i < reps; i++) {
+			setup();
+			Timer t;
+			f();
+			r.samples.push_back(t.elapsed());
+		}
+
+		printf("%-40s %12.0f %10.3f %10.3f %10.3f %10.3f %14.4g\n", name.c_str(), ops,
+			r.percentile(0) * 1e3, r.percentile(50) * 1e3, r.percentile(90) * 1e3, r.percentile(99) * 1e3, r.throughput());
+		fflush(stdout);
+		results.push_back(r);
+	}
+
+	template <typename F>
+	void run(const std::string &name, double ops, F f) {
+		run(name, ops, [] {}, f);
+	}
+
+	// Flat {"name": {"p50": seconds, ...}} objects, only what `load` needs to read back
+	void store(const std::string &file) const {
+		FILE *fp = fopen(file.c_str(), "w");
+		if (!fp) {
+			fprintf(stderr, "cannot write %s\n", file.c_str());
+			return;
+		}
+
+		fprintf(fp, "{\n");
+		for (size_t i = 0; i < results.size(); i++) {
+			const Result &r = results[i];
+			fprintf(fp, "  \"%s\": {\"ops\": %.0f, \"min\": %.9g, \"p50\": %.9g, \"p90\": %.9g, \"p99\": %.9g}%s\n", r.name.c_str(), r.ops,
+				r.percentile(0), r.percentile(50), r.percentile(90), r.percentile(99), i + 1 < results.size() ? "," : "");
+		}
+		fprintf(fp, "}\n");
+		fclose(fp);
+	}
+
+	static std::map<std::string, double> load(const std::string &file) {
+		std::map<std::string, double> res;
+		FILE *fp = fopen(file.c_str(), "r");
+		if (!fp) return res;
+
+		char line[1024], name[512];
+		double p50;
+		while (fgets(line, sizeof(line), fp)) {
+			const char *q = strstr(line, "\"p50\":");
+			if (q && sscanf(line, " \"%511[^\"]\"", name) == 1 && sscanf(q + 6, "%lf", &p50) == 1) res[name] = p50;
+		}
+		fclose(fp);
+		return res;
+	}
+
+	int finish() const {
+		int status = 0;
+		if (!compare.empty()) {
+			std::map<std::string, double> base = load(compare);
+			if (base.empty()) fprintf(stderr, "no baseline in %s\n", compare.c_str());
+
+			for (size_t i = 0; i < results.size(); i++) {
+				std::map<std::string, double>::const_iterator it = base.find(results[i].name);
+				if (it == base.end()) continue;
+
+				double now = results[i].percentile(50), change = now / it->second - 1;
+				bool bad = change > threshold;
+				printf("%-40s %+8.1f%%%s\n", results[i].name.c_str(), change * 100, bad ? "  REGRESSION" : "");
+				if (bad) status = 1;
+			}
+		}
+		if (!save.empty()) store(save);
+		return status;
+	}
+};
+
+// SplitMix64, so generated workloads are identical on every platform and standard library
+struct Random {
+	uint64_t s;
+
+	explicit Random(uint64_t seed) : s(seed) {}
+
+	uint64_t next() {
+		uint64_t z = (s += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	// Uniform in [lo, hi]
+	long long uniform(long long lo, long long hi) {
+		return lo + (long long)(next() % (uint64_t)(hi - lo + 1));
+	}
+
+	double real() {
+		return (next() >> 11) * (1.0 / (1ull << 53));
+	}
+
+	// Power-law distributed in [0, n), small values get more likely as `skew` grows
+	long long skewed(long long n, double skew) {
+		return std::min(n - 1, (long long)(n * std::pow(real(), 1 + skew)));
+	}
+};
+
+}
+}
+
+#endif // _LY_BENCH_BENCH_H
@@ -0,0 +1,175 @@
+#ifndef _LY_BENCH_GENERATORS_H
+#define _LY_BENCH_GENERATORS_H
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Bench.h"
+
+namespace ly {
+namespace Bench {
+
+// Directed edges over vertices [0, n), `w` is the weight or capacity
+struct GraphData {
+	struct Edge {
+		int u, v;
+		long long w, cost;
+	};
+
+	int n, s, t;
+	std::vector<Edge> edges;
+
+	GraphData(int n) : n(n), s(0), t(n - 1) {}
+
+	void add(int u, int v, long long w, long long cost = 0) {
+		Edge e = { u, v, w, cost };
+		edges.push_back(e);
+	}
+};
+
+// A random Hamiltonian path makes every vertex reachable from s, the other edges are uniform
+inline GraphData randomGraph(int n, int m, long long maxw, uint64_t seed, long long maxcost = 0) {
+	Random rng(seed);
+	GraphData g(n);
+
+	std::vector<int> p(n);
+	for (int i = 0; i < n; i++) p[i] = i;
+	for (int i = n - 1; i > 1; i--) std::swap(p[i], p[rng.uniform(1, i)]);
+	for (int i = 0; i + 1 < n; i++) g.add(p[i], p[i + 1], rng.uniform(1, maxw), maxcost ? rng.uniform(1, maxcost) : 0);
+	g.t = p[n - 1];
+
+	for (int i = n - 1; i < m; i++) g.add(rng.uniform(0, n - 1), rng.uniform(0, n - 1), rng.uniform(1, maxw), maxcost ? rng.uniform(1, maxcost) : 0);
+	return g;
+}
+
+// Four-neighbour grid with edges in both directions, s and t at opposite corners
+inline GraphData gridGraph(int rows, int cols, long long maxw, uint64_t seed) {
+	Random rng(seed);
+	GraphData g(rows * cols);
+
+	for (int i = 0; i < rows; i++) for (int j = 0; j < cols; j++) {
+		int v = i * cols + j;
+		if (j + 1 < cols) g.add(v, v + 1, rng.uniform(1, maxw)), g.add(v + 1, v, rng.uniform(1, maxw));
+		if (i + 1 < rows) g.add(v, v + cols, rng.uniform(1, maxw)), g.add(v + cols, v, rng.uniform(1, maxw));
+	}
+	return g;
+}
+
+// s = 0 feeds every vertex of the first layer, each vertex has `degree` edges into the next layer and the last layer drains into t
+inline GraphData layeredGraph(int layers, int width, int degree, long long maxcap, uint64_t seed) {
+	Random rng(seed);
+	GraphData g(layers * width + 2);
+
+	for (int j = 0; j < width; j++) g.add(0, 1 + j, maxcap * degree);
+	for (int i = 0; i + 1 < layers; i++) for (int j = 0; j < width; j++) {
+		for (int d = 0; d < degree; d++) g.add(1 + i * width + j, 1 + (i + 1) * width + rng.uniform(0, width - 1), rng.uniform(1, maxcap));
+	}
+	for (int j = 0; j < width; j++) g.add(1 + (layers - 1) * width + j, g.t, maxcap * degree);
+	return g;
+}
+
+// Few long rows with light vertical and heavy horizontal edges, and shuffled ids and edge order.
+// The queue keeps finding shorter detours through the rows, which is the known bad case for SPFA.
+inline GraphData spfaKiller(int rows, int cols, uint64_t seed) {
+	Random rng(seed);
+	GraphData g(rows * cols);
+
+	std::vector<int> id(rows * cols);
+	for (int i = 0; i < rows * cols; i++) id[i] = i;
+	for (int i = rows * cols - 1; i > 1; i--) std::swap(id[i], id[rng.uniform(1, i)]);
+
+	for (int i = 0; i < rows; i++) for (int j = 0; j < cols; j++) {
+		int v = id[i * cols + j];
+		if (i + 1 < rows) {
+			long long w = rng.uniform(1, 10);
+			g.add(v, id[(i + 1) * cols + j], w), g.add(id[(i + 1) * cols + j], v, w);
+		}
+		if (j + 1 < cols) {
+			long long w = rng.uniform(100000, 1000000);
+			g.add(v, id[i * cols + j + 1], w), g.add(id[i * cols + j + 1], v, w);
+		}
+	}
+	for (size_t i = g.edges.size() - 1; i > 0; i--) std::swap(g.edges[i], g.edges[rng.uniform(0, i)]);
+	g.t = id[rows * cols - 1];
+	return g;
+}
+
+// Unit capacity bipartite graph between s and t, every augmenting path is short and there are very many of them
+inline GraphData bipartiteUnit(int left, int right, int degree, uint64_t seed) {
+	Random rng(seed);
+	GraphData g(left + right + 2);
+
+	for (int i = 0; i < left; i++) {
+		g.add(0, 1 + i, 1);
+		for (int d = 0; d < degree; d++) g.add(1 + i, 1 + left + rng.uniform(0, right - 1), 1);
+	}
+	for (int j = 0; j < right; j++) g.add(1 + left + j, g.t, 1);
+	return g;
+}
+
+// Unit capacity assignment between `n` left and `n` right vertices with random costs, s = 0 and t = 2n + 1.
+// Every augmenting path is one more matched pair, so min cost flow runs n shortest path phases.
+inline GraphData assignment(int n, int degree, long long maxcost, uint64_t seed) {
+	Random rng(seed);
+	GraphData g(2 * n + 2);
+
+	for (int i = 0; i < n; i++) {
+		g.add(0, 1 + i, 1);
+		g.add(1 + i, 1 + n + i, 1, rng.uniform(1, maxcost));
+		for (int d = 1; d < degree; d++) g.add(1 + i, 1 + n + rng.uniform(0, n - 1), 1, rng.uniform(1, maxcost));
+	}
+	for (int j = 0; j < n; j++) g.add(1 + n + j, g.t, 1);
+	return g;
+}
+
+// Splay operations (type, key) using the types of test/splay.cpp, 1 insert, 2 erase, 3 rank, 4 select, 5 pred, 6 succ.
+// Keys are uniform in [0, keys) for skew = 0 and concentrate on small keys as it grows. Erase and select only
+// touch what is present, so the stream is valid when replayed from an empty tree.
+inline std::vector< std::pair<int, int> > splayOps(int n, int keys, double skew, uint64_t seed) {
+	Random rng(seed);
+	std::vector< std::pair<int, int> > ops;
+	std::vector<int> present;
+
+	for (int i = 0; i < n; i++) {
+		int type = present.empty() ? 1 : (int)rng.uniform(1, 6);
+		int key = (int)(skew > 0 ? rng.skewed(keys, skew) : rng.uniform(0, keys - 1));
+		if (type == 1) present.push_back(key);
+		else if (type == 2) {
+			size_t j = rng.uniform(0, present.size() - 1);
+			key = present[j];
+			present[j] = present.back();
+			present.pop_back();
+		} else if (type == 4) key = (int)rng.uniform(1, present.size());
+		ops.push_back(std::make_pair(type, key));
+	}
+	return ops;
+}
+
+// Whitespace separated numbers for the InputStream benchmarks, returns false when the file cannot be written
+inline bool writeIntegers(const std::string &file, size_t n, long long lo, long long hi, uint64_t seed) {
+	FILE *fp = fopen(file.c_str(), "w");
+	if (!fp) return false;
+
+	Random rng(seed);
+	for (size_t i = 0; i < n; i++) fprintf(fp, "%lld%c", rng.uniform(lo, hi), i % 16 == 15 ? '\n' : ' ');
+	fclose(fp);
+	return true;
+}
+
+inline bool writeFloats(const std::string &file, size_t n, uint64_t seed) {
+	FILE *fp = fopen(file.c_str(), "w");
+	if (!fp) return false;
+
+	Random rng(seed);
+	for (size_t i = 0; i < n; i++) fprintf(fp, "%.9g%c", (rng.real() - 0.5) * 2e6, i % 8 == 7 ? '\n' : ' ');
+	fclose(fp);
+	return true;
+}
+
+}
+}
+
+#endif // _LY_BENCH_GENERATORS_H
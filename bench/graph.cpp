@@ -0,0 +1,73 @@
+#include <climits>
+#include <cstdio>
+#include <ly.h>
+
+#include "Bench.h"
+#include "Generators.h"
+
+using namespace ly::Bench;
+
+const int MAXN = 1 << 18;
+
+ly::Menci::Graph::ShortestPath<MAXN, long long, LLONG_MAX> sp;
+ly::Menci::Graph::NetworkFlow<MAXN, long long, LLONG_MAX> flow;
+ly::Menci::Graph::BipartiteMatching<MAXN> matching;
+
+void shortestPath(Runner &runner, const std::string &name, const GraphData &g) {
+	sp.clear();
+	for (size_t i = 0; i < g.edges.size(); i++) sp.addEdge(g.edges[i].u, g.edges[i].v, g.edges[i].w);
+
+	runner.run("sp/spfa/" + name, g.edges.size(), [&] { keep(sp.spfa(g.s)); });
+	runner.run("sp/dijkstra/" + name, g.edges.size(), [&] { keep(sp.dijkstra(g.s)); });
+}
+
+void maxFlow(Runner &runner, const std::string &name, const GraphData &g) {
+	flow.clear();
+	for (size_t i = 0; i < g.edges.size(); i++) flow.addEdge(g.edges[i].u, g.edges[i].v, g.edges[i].w);
+
+	long long expect = -1;
+	runner.run("flow/dinic/" + name, g.edges.size(), [&] { flow.resetFlow(); }, [&] { keep(expect = flow.dinic(g.s, g.t, g.n)); });
+	runner.run("flow/pushrelabel-1/" + name, g.edges.size(), [&] { flow.resetFlow(); }, [&] {
+		long long f = flow.pushrelabel(g.s, g.t, g.n, 1);
+		if (expect != -1 && f != expect) fprintf(stderr, "%s: push-relabel %lld, dinic %lld\n", name.c_str(), f, expect);
+	});
+	runner.run("flow/pushrelabel-all/" + name, g.edges.size(), [&] { flow.resetFlow(); }, [&] { keep(flow.pushrelabel(g.s, g.t, g.n)); });
+}
+
+void minCostFlow(Runner &runner, const std::string &name, const GraphData &g) {
+	flow.clear();
+	for (size_t i = 0; i < g.edges.size(); i++) flow.addEdge(g.edges[i].u, g.edges[i].v, g.edges[i].w, g.edges[i].cost);
+
+	long long f, c;
+	runner.run("costflow/primaldual/" + name, g.edges.size(), [&] { flow.resetFlow(); }, [&] { flow.primaldual(g.s, g.t, g.n, f, c); keep(c); });
+	runner.run("costflow/edmondskarp/" + name, g.edges.size(), [&] { flow.resetFlow(); }, [&] { flow.edmondskarp(g.s, g.t, g.n, f, c); keep(c); });
+}
+
+int main(int argc, char **argv) {
+	Runner runner(argc, argv);
+
+	shortestPath(runner, "random-100k-500k", randomGraph(100000, 500000, 1000000, 1));
+	shortestPath(runner, "grid-300x300", gridGraph(300, 300, 1000000, 2));
+	// SPFA degrades badly here, the adversarial grid is kept small enough to finish in a few seconds
+	shortestPath(runner, "spfa-killer-6x2000", spfaKiller(6, 2000, 3));
+
+	maxFlow(runner, "random-5k-50k", randomGraph(5000, 50000, 1000, 4));
+	maxFlow(runner, "layered-20x500x4", layeredGraph(20, 500, 4, 1000, 5));
+	maxFlow(runner, "grid-200x200", gridGraph(200, 200, 1000, 6));
+	maxFlow(runner, "bipartite-unit-20k", bipartiteUnit(20000, 20000, 5, 7));
+
+	minCostFlow(runner, "random-1k-10k", randomGraph(1000, 10000, 50, 8, 1000));
+	// Primal-dual gains little on the random graph above and clearly wins on assignment instances, where one
+	// Dijkstra phase serves many unit augmenting paths that edmondskarp finds with an SPFA each
+	minCostFlow(runner, "assignment-1k-5", assignment(1000, 5, 1000, 10));
+
+	GraphData b = bipartiteUnit(100000, 100000, 5, 9);
+	matching.clear();
+	for (size_t i = 0; i < b.edges.size(); i++) {
+		const GraphData::Edge &e = b.edges[i];
+		if (e.u != 0 && e.v != b.t) matching.addEdge(e.u - 1, e.v - 1 - 100000);
+	}
+	runner.run("matching/hopcroftkarp/random-100k-500k", b.edges.size(), [&] { keep(matching.hopcroftkarp(100000, 100000)); });
+
+	return runner.finish();
+}
@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <ly.h>
+
+#include "Bench.h"
+#include "Generators.h"
+
+using namespace ly::Bench;
+
+// The fallback buffer makes InputStream too large for the stack
+ly::Utility::InputStream *in;
+
+std::string path(const char *name) {
+	const char *dir = getenv("TMPDIR");
+	return std::string(dir && *dir ? dir : "/tmp") + "/ly-bench-" + name;
+}
+
+template <typename T>
+void readAll(Runner &runner, const std::string &name, const std::string &file, size_t n) {
+	runner.run("io/InputStream/" + name, n, [&] {
+		delete in;
+		in = nullptr;
+	}, [&] {
+		in = new ly::Utility::InputStream(file.c_str());
+		T x = T();
+		double sum = 0;
+		for (size_t i = 0; i < n; i++) *in >> x, sum += x;
+		keep(sum);
+	});
+}
+
+template <typename T>
+void scanAll(Runner &runner, const std::string &name, const std::string &file, size_t n, const char *format) {
+	runner.run("io/scanf/" + name, n, [&] {
+		FILE *fp = fopen(file.c_str(), "r");
+		T x = T();
+		double sum = 0;
+		for (size_t i = 0; i < n && fscanf(fp, format, &x) == 1; i++) sum += x;
+		fclose(fp);
+		keep(sum);
+	});
+}
+
+int main(int argc, char **argv) {
+	Runner runner(argc, argv);
+
+	const size_t N = 10000000;
+	std::string ints = path("ints"), longs = path("longs"), floats = path("floats");
+	if (!writeIntegers(ints, N, -1000000000, 1000000000, 1) || !writeIntegers(longs, N, -(1ll << 62), 1ll << 62, 2) || !writeFloats(floats, N / 4, 3)) {
+		fprintf(stderr, "cannot write the input files\n");
+		return 2;
+	}
+
+	readAll<int>(runner, "int-10m", ints, N);
+	readAll<long long>(runner, "long-long-10m", longs, N);
+	readAll<double>(runner, "double-2.5m", floats, N / 4);
+	scanAll<int>(runner, "int-10m", ints, N, "%d");
+	scanAll<double>(runner, "double-2.5m", floats, N / 4, "%lf");
+
+	delete in;
+	remove(ints.c_str());
+	remove(longs.c_str());
+	remove(floats.c_str());
+	return runner.finish();
+}
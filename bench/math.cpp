@@ -0,0 +1,102 @@
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <ly.h>
+
+#include "Bench.h"
+
+using namespace ly::Bench;
+using namespace ly::Menci::Math;
+using namespace ly::Menci::DataStructure;
+
+typedef ModInt<998244353> M;
+
+int main(int argc, char **argv) {
+	Runner runner(argc, argv);
+	Random rng(1);
+
+	std::vector<uint64_t> odd(100000);
+	for (size_t i = 0; i < odd.size(); i++) odd[i] = rng.next() | 1;
+	runner.run("nt/isPrime/u64-100k", odd.size(), [&] {
+		int c = 0;
+		for (size_t i = 0; i < odd.size(); i++) c += NumberTheory::isPrime(odd[i]);
+		keep(c);
+	});
+	std::unique_ptr<bool[]> res(new bool[odd.size()]);
+	runner.run("nt/isPrime-batch/u64-100k", odd.size(), [&] {
+		NumberTheory::isPrime(odd.data(), res.get(), odd.size());
+		keep(res[0]);
+	});
+
+	std::vector<uint64_t> semi(200);
+	for (size_t i = 0; i < semi.size(); i++) semi[i] = rng.next() >> 2;
+	runner.run("nt/factorize/u62-200", semi.size(), [&] {
+		size_t s = 0;
+		for (size_t i = 0; i < semi.size(); i++) s += NumberTheory::factorize(semi[i]).size();
+		keep(s);
+	});
+
+	std::vector<unsigned long long> g(1000000);
+	for (size_t i = 0; i < g.size(); i++) g[i] = rng.next();
+	runner.run("nt/gcd/u64-1m", g.size(), [&] {
+		unsigned long long s = 0;
+		for (size_t i = 0; i + 1 < g.size(); i++) s += NumberTheory::gcd(g[i], g[i + 1]);
+		keep(s);
+	});
+
+	std::vector<long long> a(1000000), r(1000000);
+	for (size_t i = 0; i < a.size(); i++) a[i] = rng.uniform(1, 1000000006);
+	runner.run("nt/batchInv/1m", a.size(), [&] {
+		NumberTheory::batchInv(a.data(), r.data(), a.size(), 1000000007LL);
+		keep(r[0]);
+	});
+
+	runner.run("nt/DiscreteLog/1e9+7-100", 100, [&] {
+		NumberTheory::DiscreteLog<long long> log(5, 1000000007, 100);
+		long long s = 0;
+		for (int i = 1; i <= 100; i++) s += log.log(i);
+		keep(s);
+	});
+
+	SegmentedSieve sieve;
+	runner.run("sieve/count/1e9", 1e9, [&] { keep(sieve.count(0, 1000000000)); });
+	runner.run("sieve/linear/1e7", 1e7, [&] { LinearSieve s(10000000); keep(s.primes.size()); });
+
+	std::vector<M> x(1 << 19), y(1 << 19);
+	for (size_t i = 0; i < x.size(); i++) x[i] = M(rng.next()), y[i] = M(rng.next());
+	runner.run("poly/ntt-multiply/2^19", x.size(), [&] { keep(NTT<998244353>::multiply(x, y)[0]); });
+
+	std::vector<uint32_t> u(1 << 18), v(1 << 18);
+	for (size_t i = 0; i < u.size(); i++) u[i] = rng.uniform(0, 1000000006), v[i] = rng.uniform(0, 1000000006);
+	runner.run("poly/convolution-mod-1e9+7/2^18", u.size(), [&] { keep(Convolution::multiply(u, v, 1000000007)[0]); });
+
+	Polynomial<M> f(x.begin(), x.begin() + 200000);
+	f[0] = M(1);
+	runner.run("poly/inv/200k", f.size(), [&] { keep(f.inv(f.size())[0]); });
+	runner.run("poly/exp/100k", 100000, [&] {
+		Polynomial<M> h = f.truncate(100000);
+		h[0] = M(0);
+		keep(h.exp(100000)[0]);
+	});
+
+	ModMatrix A(200, 200, 1000000007), B(200, 200, (1ull << 61) - 1);
+	for (size_t i = 0; i < A.a.size(); i++) A.a[i] = rng.uniform(0, 1000000006), B.a[i] = rng.next() % B.mod;
+	runner.run("matrix/multiply/200-mod-1e9+7", 200.0 * 200 * 200, [&] { keep((A * A).a[0]); });
+	runner.run("matrix/multiply/200-mod-2^61-1", 200.0 * 200 * 200, [&] { keep((B * B).a[0]); });
+
+	std::vector<M> c(1000), init(1000);
+	for (size_t i = 0; i < c.size(); i++) c[i] = M(rng.next()), init[i] = M(rng.next());
+	runner.run("recurrence/kitamasa/k1000-n1e18", 1, [&] { keep(LinearRecurrence<M>(init, c)(1000000000000000000ull)); });
+
+	std::vector<long long> keys(1000000);
+	for (size_t i = 0; i < keys.size(); i++) keys[i] = rng.next() >> 1;
+	runner.run("hashtable/insert-find/1m", 2 * keys.size(), [&] {
+		HashTable<long long, long long> t;
+		for (size_t i = 0; i < keys.size(); i++) t.insert(std::make_pair(keys[i], (long long)i));
+		long long s = 0;
+		for (size_t i = 0; i < keys.size(); i++) s += t.find(keys[i])->second;
+		keep(s);
+	});
+
+	return runner.finish();
+}
@@ -0,0 +1,54 @@
+#!/bin/sh
+# Builds and runs the benchmarks. Every benchmark is a single translation unit, so no build system is needed.
+#
+#   bench/run.sh [-s DIR] [-c DIR] [NAME...] [-- OPTIONS]
+#
+#   NAME        graph, splay, io or math, all of them by default
+#   -s DIR      save a JSON baseline per benchmark as DIR/NAME.json
+#   -c DIR      compare against DIR/NAME.json, the exit status is 1 on a regression
+#   OPTIONS     passed to every binary, e.g. --reps=20 --filter=dinic --threshold=0.05
+#
+# CXX and CXXFLAGS override the compiler and flags, binaries go to bench/build.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--std=c++11 -O2 -march=native -pthread}
+BUILD=$ROOT/bench/build
+SAVE=
+COMPARE=
+
+while getopts "s:c:" opt; do
+	case $opt in
+		s) SAVE=$OPTARG ;;
+		c) COMPARE=$OPTARG ;;
+		*) exit 2 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+NAMES=
+while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+	NAMES="$NAMES $1"
+	shift
+done
+[ "$1" = "--" ] && shift
+[ -z "$NAMES" ] && NAMES="graph splay io math"
+
+mkdir -p "$BUILD"
+[ -n "$SAVE" ] && mkdir -p "$SAVE"
+
+STATUS=0
+for name in $NAMES; do
+	echo "== $name"
+	# The repository root is the include path, as when ly.h is installed
+	$CXX $CXXFLAGS -I"$ROOT" -o "$BUILD/$name" "$ROOT/bench/$name.cpp"
+
+	ARGS=
+	[ -n "$SAVE" ] && ARGS="$ARGS --save=$SAVE/$name.json"
+	[ -n "$COMPARE" ] && ARGS="$ARGS --compare=$COMPARE/$name.json"
+	"$BUILD/$name" $ARGS "$@" || STATUS=1
+done
+
+exit $STATUS
@@ -0,0 +1,47 @@
+#include <cstdio>
+#include <ly.h>
+
+#include "Bench.h"
+#include "Generators.h"
+
+using namespace ly::Bench;
+
+ly::Menci::DataStructure::Splay<int> splay;
+
+// Empties the tree left by the previous repetition, the splay tree has no clear of its own
+void drain() {
+	while (splay.size()) splay.erase(splay.select(1));
+}
+
+void replay(Runner &runner, const std::string &name, const std::vector< std::pair<int, int> > &ops) {
+	runner.run("splay/" + name, ops.size(), drain, [&] {
+		long long sum = 0;
+		for (size_t i = 0; i < ops.size(); i++) {
+			int opt = ops[i].first, x = ops[i].second;
+			if (opt == 1) splay.insert(x);
+			else if (opt == 2) splay.erase(x);
+			else if (opt == 3) sum += splay.rank(x);
+			else if (opt == 4) sum += splay.select(x);
+			else if (opt == 5) sum += splay.pred(x);
+			else sum += splay.succ(x);
+		}
+		keep(sum);
+	});
+}
+
+int main(int argc, char **argv) {
+	Runner runner(argc, argv);
+
+	replay(runner, "uniform-1m", splayOps(1000000, 1000000000, 0, 1));
+	replay(runner, "uniform-small-keys-1m", splayOps(1000000, 1000, 0, 2));
+	replay(runner, "skewed-1m", splayOps(1000000, 1000000000, 4, 3));
+
+	// Sorted insertions build a path that the first access has to splay apart
+	std::vector< std::pair<int, int> > sorted;
+	for (int i = 0; i < 1000000; i++) sorted.push_back(std::make_pair(1, i));
+	for (int i = 0; i < 1000000; i++) sorted.push_back(std::make_pair(3, i));
+	replay(runner, "sorted-insert-then-rank-1m", sorted);
+
+	drain();
+	return runner.finish();
+}
@@ -0,0 +1,111 @@
+#ifndef _LY_MENCI_DATASTRUCTURE_HASHTABLE_H
+#define _LY_MENCI_DATASTRUCTURE_HASHTABLE_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ly {
+namespace Menci {
+namespace DataStructure {
+
+// Open addressing with linear probing on a power-of-two flat array, for integer keys.
+// Entries are never erased, iterators are pointers and `end()` is nullptr, so it drops in for std::map in lookups.
+template <typename Key, typename Value>
+struct HashTable {
+	struct Entry {
+		Key first;
+		Value second;
+	};
+
+	typedef Entry *iterator;
+
+private:
+	std::vector<Entry> entries;
+	std::vector<bool> used;
+	size_t mask, filled;
+	int shift;
+
+	// Fibonacci hashing, the high bits of the product are the best mixed
+	size_t slot(const Key &k) const {
+		return (uint64_t)k * 0x9e3779b97f4a7c15ull >> shift;
+	}
+
+	void rehash(size_t capacity) {
+		std::vector<Entry> old;
+		std::vector<bool> oldUsed;
+		old.swap(entries);
+		oldUsed.swap(used);
+
+		shift = 64;
+		for (size_t c = capacity; c > 1; c /= 2) shift--;
+		entries.resize(capacity);
+		used.assign(capacity, false);
+		mask = capacity - 1;
+		filled = 0;
+
+		for (size_t i = 0; i < old.size(); i++) if (oldUsed[i]) insert(std::make_pair(old[i].first, old[i].second));
+	}
+
+public:
+	HashTable(size_t n = 0) : mask(0), filled(0), shift(64) {
+		reserve(n);
+	}
+
+	// Room for `n` keys below half load
+	void reserve(size_t n) {
+		size_t capacity = 16;
+		while (capacity < 2 * n) capacity *= 2;
+		if (capacity > entries.size()) rehash(capacity);
+	}
+
+	size_t size() const {
+		return filled;
+	}
+
+	void clear() {
+		used.assign(used.size(), false);
+		filled = 0;
+	}
+
+	iterator end() const {
+		return nullptr;
+	}
+
+	iterator find(const Key &k) {
+		for (size_t i = slot(k); used[i]; i = (i + 1) & mask) {
+			if (entries[i].first == k) return &entries[i];
+		}
+		return nullptr;
+	}
+
+	size_t count(const Key &k) {
+		return find(k) != nullptr;
+	}
+
+	// Keeps the existing value like std::map::insert
+	std::pair<iterator, bool> insert(const std::pair<Key, Value> &p) {
+		if (2 * (filled + 1) > entries.size()) rehash(entries.size() * 2);
+
+		size_t i = slot(p.first);
+		for (; used[i]; i = (i + 1) & mask) {
+			if (entries[i].first == p.first) return std::make_pair(&entries[i], false);
+		}
+
+		used[i] = true;
+		entries[i].first = p.first;
+		entries[i].second = p.second;
+		filled++;
+		return std::make_pair(&entries[i], true);
+	}
+
+	Value &operator[](const Key &k) {
+		return insert(std::make_pair(k, Value())).first->second;
+	}
+};
+
+}
+}
+}
+
+#endif // _LY_MENCI_DATASTRUCTURE_HASHTABLE_H
@@ -3,11 +3,14 @@
 
 #include <algorithm>
 
+#include "../../Utility/Stats.h"
+
 namespace ly {
 namespace Menci {
 namespace DataStructure {
 
-template < typename T, typename Comp = std::less<T> >
+// `S` 为 Utility::Stats 时累计旋转次数，Utility::NoStats 不产生任何开销
+template < typename T, typename Comp = std::less<T>, typename S = Utility::DefaultStats >
 struct Splay {
 private:
     struct Node {
@@ -71,18 +74,24 @@ private:
 
         // 旋转到某一特定位置，如在删除时将后继节点旋转为根的右儿子
         // target 为目标父节点，缺省参数为 nullptr，即旋转直到成为根（没有父节点）
-        void splay(Node *target = nullptr) {
+        // 返回旋转的次数
+        int splay(Node *target = nullptr) {
+            int rotations = 0;
             while (fa != target) { // while (父节点不是目标父节点)
                 if (fa->fa == target) { // 父节点的父节点是目标父节点，直接转一次
                     rotate();
+                    rotations++;
                 } else if (fa->relation() == relation()) { // 关系相同，先转父节点，再转自身
                     fa->rotate();
                     rotate();
+                    rotations += 2;
                 } else {
                     rotate();
                     rotate();
+                    rotations += 2;
                 }
             }
+            return rotations;
         }
 
         // 前趋，全称 precursor 或 predecessor
@@ -149,7 +158,7 @@ private:
             (*v) = new Node(&root, fa, x, bound);
         }
 
-        (*v)->splay();
+        stats.count(S::ROTATIONS, (*v)->splay());
 
         // 伸展之后，*v 这个位置存的可能不再是新节点（因为父子关系改变了，而 v 一般指向一个节点的某个子节点的位置）
         // 直接返回根
@@ -171,11 +180,13 @@ private:
             }
         }
 
-        if (v) v->splay();
+        if (v) stats.count(S::ROTATIONS, v->splay());
         return v;
     }
 
 public:
+    S stats;
+
     Splay() : root(nullptr) {
         insert(T(), -1);
         insert(T(), 1);
@@ -198,8 +209,8 @@ public:
     // 删除一个节点
     void erase(Node *v) {
         Node *pred = v->pred(), *succ = v->succ();
-        pred->splay();
-        succ->splay(pred); // 使后继成为前趋（根）的右儿子
+        stats.count(S::ROTATIONS, pred->splay());
+        stats.count(S::ROTATIONS, succ->splay(pred)); // 使后继成为前趋（根）的右儿子
 
         // 此时后继的左儿子即为要删除的节点 v，且 v 此时为叶子节点
 
@@ -278,7 +289,7 @@ public:
                 v = v->ch[1];
             }
         }
-        v->splay();
+        stats.count(S::ROTATIONS, v->splay());
         return v->x;
     }
 };
@@ -0,0 +1,177 @@
+#ifndef _LY_MENCI_GRAPH_BIPARTITEMATCHING_H
+#define _LY_MENCI_GRAPH_BIPARTITEMATCHING_H
+
+#include <climits>
+#include <utility>
+#include <vector>
+
+namespace ly {
+namespace Menci {
+namespace Graph {
+
+// Hopcroft-Karp on flat adjacency arrays, left and right vertices are numbered independently
+template <int MAXN>
+struct BipartiteMatching {
+private:
+	const static int INF = INT_MAX;
+
+	std::vector< std::pair<int, int> > edges;
+	std::vector<int> adj;
+	int nl, nr;
+	// Layer of the left vertices adjacent to a free right vertex, set the length of this phase's shortest paths
+	int limit;
+	int head[MAXN + 1], it[MAXN], dist[MAXN], stack[MAXN], queue[MAXN];
+	int matchL[MAXN], matchR[MAXN];
+	bool visL[MAXN], visR[MAXN];
+
+	void build() {
+		for (int i = 0; i <= nl; i++) head[i] = 0;
+		for (size_t i = 0; i < edges.size(); i++) head[edges[i].first + 1]++;
+		for (int i = 0; i < nl; i++) head[i + 1] += head[i];
+
+		adj.resize(edges.size());
+		for (int i = 0; i < nl; i++) it[i] = head[i];
+		for (size_t i = 0; i < edges.size(); i++) adj[it[edges[i].first]++] = edges[i].second;
+	}
+
+	int greedy() {
+		int res = 0;
+		for (int u = 0; u < nl; u++) {
+			for (int i = head[u]; i < head[u + 1]; i++) {
+				if (matchR[adj[i]] == -1) {
+					matchL[u] = adj[i];
+					matchR[adj[i]] = u;
+					res++;
+					break;
+				}
+			}
+		}
+		return res;
+	}
+
+	// Layers the left vertices by alternating distance from the free ones, stopping at the first free right vertex.
+	// Vertices layered before the limit was found may sit one past it, augment never enters them.
+	bool level() {
+		int l = 0, r = 0;
+		limit = INF;
+		for (int u = 0; u < nl; u++) {
+			if (matchL[u] == -1) dist[u] = 0, queue[r++] = u;
+			else dist[u] = INF;
+		}
+
+		while (l < r) {
+			int u = queue[l++];
+			if (dist[u] >= limit) continue;
+
+			for (int i = head[u]; i < head[u + 1]; i++) {
+				int w = matchR[adj[i]];
+				if (w == -1) limit = dist[u];
+				else if (dist[w] == INF && dist[u] < limit) dist[w] = dist[u] + 1, queue[r++] = w;
+			}
+		}
+
+		return limit != INF;
+	}
+
+	// Iterative DFS along the layers, current arcs in `it`. Only shortest paths are taken, so a free
+	// right vertex ends a path at the limit layer and no deeper layer is entered.
+	bool augment(int root) {
+		int top = 0;
+		stack[top++] = root;
+
+		while (top) {
+			int u = stack[top - 1];
+			if (it[u] == head[u + 1]) {
+				dist[u] = INF;
+				top--;
+				continue;
+			}
+
+			int w = matchR[adj[it[u]]];
+			if (w == -1 && dist[u] == limit) {
+				while (top) {
+					u = stack[--top];
+					matchL[u] = adj[it[u]];
+					matchR[adj[it[u]]] = u;
+				}
+				return true;
+			}
+
+			if (w != -1 && dist[w] == dist[u] + 1 && dist[w] <= limit) stack[top++] = w;
+			else it[u]++;
+		}
+
+		return false;
+	}
+
+public:
+	inline void addEdge(int u, int v) {
+		edges.push_back(std::make_pair(u, v));
+	}
+
+	inline void clear() {
+		edges.clear();
+		adj.clear();
+	}
+
+	int hopcroftkarp(int nl, int nr) {
+		this->nl = nl;
+		this->nr = nr;
+
+		for (int i = 0; i < nl; i++) matchL[i] = -1;
+		for (int i = 0; i < nr; i++) matchR[i] = -1;
+
+		build();
+
+		int res = greedy();
+		while (level()) {
+			for (int u = 0; u < nl; u++) it[u] = head[u];
+			for (int u = 0; u < nl; u++) if (matchL[u] == -1 && augment(u)) res++;
+		}
+		return res;
+	}
+
+	// Right vertex matched with left vertex `u`, or -1
+	inline int getMatch(int u) {
+		return matchL[u];
+	}
+
+	void getMatching(std::vector< std::pair<int, int> > &res) {
+		res.clear();
+		for (int u = 0; u < nl; u++) if (matchL[u] != -1) res.push_back(std::make_pair(u, matchL[u]));
+	}
+
+	// Minimum vertex cover by Konig's theorem, from the alternating reachability of the free left vertices
+	void vertexCover(std::vector<int> &left, std::vector<int> &right) {
+		int l = 0, r = 0;
+		for (int u = 0; u < nl; u++) {
+			visL[u] = matchL[u] == -1;
+			if (visL[u]) queue[r++] = u;
+		}
+		for (int v = 0; v < nr; v++) visR[v] = false;
+
+		while (l < r) {
+			int u = queue[l++];
+			for (int i = head[u]; i < head[u + 1]; i++) {
+				int v = adj[i];
+				if (visR[v]) continue;
+				visR[v] = true;
+				if (matchR[v] != -1 && !visL[matchR[v]]) {
+					visL[matchR[v]] = true;
+					queue[r++] = matchR[v];
+				}
+			}
+		}
+
+		left.clear();
+		right.clear();
+		for (int u = 0; u < nl; u++) if (!visL[u]) left.push_back(u);
+		for (int v = 0; v < nr; v++) if (visR[v]) right.push_back(v);
+	}
+};
+
+}
+}
+}
+
+#endif // _LY_MENCI_GRAPH_BIPARTITEMATCHING_H
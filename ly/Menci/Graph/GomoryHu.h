@@ -0,0 +1,85 @@
+#ifndef _LY_MENCI_GRAPH_GOMORYHU_H
+#define _LY_MENCI_GRAPH_GOMORYHU_H
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#include "NetworkFlow.h"
+
+namespace ly {
+namespace Menci {
+namespace Graph {
+
+// Gomory-Hu tree of an undirected graph by Gusfield's algorithm, n - 1 max flows on one residual graph
+template <int MAXN, typename T = int, T MAX = INT_MAX>
+struct GomoryHu {
+private:
+	NetworkFlow<MAXN, T, MAX> graph;
+	int fa[MAXN], dep[MAXN];
+	T w[MAXN];
+	bool mark[MAXN];
+
+public:
+	inline void addEdge(int u, int v, T cap) {
+		graph.addEdge(u, v, cap);
+		graph.addEdge(v, u, cap);
+	}
+
+	inline void clear() {
+		graph.clear();
+	}
+
+	// The flows depend on the parents found by the previous ones, `threads` is handed to each max flow
+	void build(int n, unsigned threads = 1) {
+		std::vector<int> side, cut;
+
+		for (int i = 0; i < n; i++) {
+			fa[i] = 0;
+			mark[i] = false;
+		}
+		w[0] = MAX;
+		dep[0] = 0;
+
+		for (int i = 1; i < n; i++) {
+			graph.resetFlow();
+			w[i] = threads > 1 ? graph.pushrelabel(i, fa[i], n, threads) : graph.dinic(i, fa[i], n);
+
+			graph.minCut(i, n, side, cut);
+			for (size_t j = 0; j < side.size(); j++) mark[side[j]] = true;
+			for (int j = i + 1; j < n; j++) if (mark[j] && fa[j] == fa[i]) fa[j] = i;
+			for (size_t j = 0; j < side.size(); j++) mark[side[j]] = false;
+		}
+
+		// Parents always have smaller indices
+		for (int i = 1; i < n; i++) dep[i] = dep[fa[i]] + 1;
+
+		graph.resetFlow();
+	}
+
+	inline int getParent(int u) {
+		return fa[u];
+	}
+
+	// Min cut between `u` and its parent
+	inline T getWeight(int u) {
+		return w[u];
+	}
+
+	// Lightest edge on the tree path
+	T minCut(int u, int v) {
+		T res = MAX;
+		while (u != v) {
+			if (dep[u] < dep[v]) std::swap(u, v);
+			res = std::min(res, w[u]);
+			u = fa[u];
+		}
+		return res;
+	}
+};
+
+}
+}
+}
+
+#endif // _LY_MENCI_GRAPH_GOMORYHU_H
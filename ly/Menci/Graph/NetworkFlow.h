@@ -1,14 +1,23 @@
 #ifndef _LY_MENCI_GRAPH_NETWORKFLOW_H
 #define _LY_MENCI_GRAPH_NETWORKFLOW_H
 
+#include <atomic>
 #include <climits>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <thread>
+#include <vector>
+
+#include "../../Utility/Stats.h"
 
 namespace ly {
 namespace Menci {
 namespace Graph {
 
-template <int MAXN, typename T = int, T MAX = INT_MAX>
+// `S` is Utility::Stats to count phases, augmentations and pushes and time them per call, Utility::NoStats costs nothing
+template <int MAXN, typename T = int, T MAX = INT_MAX, typename S = Utility::DefaultStats>
 struct NetworkFlow {
 private:
 	struct Node;
@@ -16,7 +25,7 @@ private:
 
 	struct Node {
 		struct Edge *e, *c;
-		T d, f, l;
+		T d, f, l, h;
 		bool inq;
 	} N[MAXN];
 
@@ -24,17 +33,65 @@ private:
 		Node *s, *t;
 		T f, c, w;
 		Edge *next, *r;
+		int i;
 
-		Edge(Node *s, Node *t, T c, T w) : s(s), t(t), f(0), c(c), w(w), next(s->e), r(nullptr) {}
+		Edge(Node *s, Node *t, T c, T w, int i) : s(s), t(t), f(0), c(c), w(w), next(s->e), r(nullptr), i(i) {}
 	};
 
+	std::vector<Edge *> E;
+
 public:
-	inline void addEdge(int s, int t, T cap, T cost = 0) {
-		Edge *e1 = N[s].e = new Edge(&N[s], &N[t], cap, cost);
-		Edge *e2 = N[t].e = new Edge(&N[t], &N[s], 0, -cost);
+	S stats;
+
+	// Returns the id of the new edge, its reverse edge is `id ^ 1`
+	inline int addEdge(int s, int t, T cap, T cost = 0) {
+		Edge *e1 = N[s].e = new Edge(&N[s], &N[t], cap, cost, E.size());
+		E.push_back(e1);
+		Edge *e2 = N[t].e = new Edge(&N[t], &N[s], 0, -cost, E.size());
+		E.push_back(e2);
 
 		e1->r = e2;
 		e2->r = e1;
+
+		return e1->i;
+	}
+
+	inline T getFlow(int id) {
+		return E[id]->f;
+	}
+
+	inline T getCapacity(int id) {
+		return E[id]->c;
+	}
+
+	// The current flow stays feasible, call a max flow again to augment the difference
+	inline void increaseCapacity(int id, T delta) {
+		E[id]->c += delta;
+	}
+
+	// Reroutes or cancels the flow above the new capacity, returns how much the s-t flow dropped.
+	// A maximum flow stays maximum, since the cancelled paths can open residual s-t paths avoiding the edge.
+	// `delta` should not exceed the current capacity, a larger one is clamped so the capacity ends at 0
+	T decreaseCapacity(int id, T delta, int s, int t, int n) {
+		Edge *e = E[id];
+		e->c -= std::min(delta, e->c);
+
+		T over = e->f - e->c;
+		if (!(over > 0)) return 0;
+
+		e->f -= over;
+		e->r->f += over;
+
+		int u = e->s - N, v = e->t - N;
+		if (u == v) return 0;
+
+		T lost = over - dinic(u, v, n, over);
+		if (lost > 0) {
+			if (u != s) dinic(u, s, n, lost);
+			if (v != t) dinic(t, v, n, lost);
+			lost -= dinic(s, t, n, lost);
+		}
+		return lost;
 	}
 
 	inline void clear() {
@@ -42,18 +99,27 @@ public:
 		for (int i = 0; i < MAXN; i++) {
 			for (Edge *&e = N[i].e, *next; e; next = e->next, delete e, e = next);
 		}
+		E.clear();
+	}
+
+	// Drops the flow on every edge, keeping the capacities
+	inline void resetFlow() {
+		for (size_t i = 0; i < E.size(); i++) E[i]->f = 0;
 	}
 
 	inline void reset() {
 		for (int i = 0; i < MAXN; i++) {
 			N[i].inq = false;
 			N[i].c = nullptr;
-			N[i].d = N[i].f = N[i].l = 0;
+			N[i].d = N[i].f = N[i].l = N[i].h = 0;
 		}
 	}
 
 private:
 	bool dinicLevel(Node *s, Node *t, int n) {
+		typename S::Scope scope(stats, S::SEARCH);
+		stats.count(S::PHASES);
+
 		for (int i = 0; i < n; i++) {
 			N[i].c = N[i].e;
 			N[i].l = 0;
@@ -63,6 +129,7 @@ private:
 
 		s->l = 1;
 		q.push(s);
+		stats.count(S::QUEUE_PUSHES);
 
 		while (!q.empty()) {
 			Node *v = q.front();
@@ -72,7 +139,8 @@ private:
 				if (e->f < e->c && !e->t->l) {
 					e->t->l = v->l + 1;
 					if (e->t == t) return true;
-					else q.push(e->t);
+					q.push(e->t);
+					stats.count(S::QUEUE_PUSHES);
 				}
 			}
 		}
@@ -85,7 +153,7 @@ private:
 
 		for (Edge *&e = s->c; e; e = e->next) {
 			if (e->f < e->c && e->t->l == s->l + 1) {
-				int f = dinicFind(e->t, t, std::min(limit, e->c - e->f));
+				T f = dinicFind(e->t, t, std::min(limit, e->c - e->f));
 				if (f) {
 					e->f += f;
 					e->r->f -= f;
@@ -98,19 +166,53 @@ private:
 	}
 
 public:
-	T dinic(int s, int t, int n) {
+	// Continues from the flow already in the graph, `limit` bounds the extra flow pushed
+	T dinic(int s, int t, int n, T limit = MAX) {
+		stats.reset();
+		typename S::Scope scope(stats, S::TOTAL);
+
 		T res = 0;
-		while (dinicLevel(&N[s], &N[t], n)) {
+		while (res < limit && dinicLevel(&N[s], &N[t], n)) {
+			typename S::Scope augment(stats, S::AUGMENT);
 			T f;
-			while ((f = dinicFind(&N[s], &N[t])) > 0) res += f;
+			while (res < limit && (f = dinicFind(&N[s], &N[t], limit - res)) > 0) {
+				res += f;
+				stats.count(S::AUGMENTATIONS);
+			}
 		}
 		return res;
 	}
 
+	// After a max flow from `s`, collect the nodes reachable in the residual graph and the ids of the
+	// saturated edges leaving them
+	void minCut(int s, int n, std::vector<int> &side, std::vector<int> &cut) {
+		side.clear();
+		cut.clear();
+
+		// The BFS is not part of the preceding flow run, so its counts are dropped
+		S saved = stats;
+		dinicLevel(&N[s], nullptr, n);
+		stats = saved;
+
+		for (int i = 0; i < n; i++) {
+			if (!N[i].l) continue;
+			side.push_back(i);
+			for (Edge *e = N[i].e; e; e = e->next) {
+				if (!(e->i & 1) && !e->t->l) cut.push_back(e->i);
+			}
+		}
+	}
+
 	// In EK, use var `c` for in edge
 	void edmondskarp(int s, int t, int n, T &flow, T &cost) {
+		stats.reset();
+		typename S::Scope scope(stats, S::TOTAL);
+
 		flow = cost = 0;
 		while (1) {
+			typename S::Scope search(stats, S::SEARCH);
+			stats.count(S::PHASES);
+
 			for (int i = 0; i < n; i++) {
 				N[i].c = nullptr;
 				N[i].inq = false;
@@ -124,6 +226,7 @@ public:
 
 			std::queue<Node *> q;
 			q.push(&N[s]);
+			stats.count(S::QUEUE_PUSHES);
 
 			while (!q.empty()) {
 				Node *v = q.front();
@@ -136,9 +239,11 @@ public:
 						e->t->d = v->d + e->w;
 						e->t->c = e;
 						e->t->f = std::min(v->f, e->c - e->f);
+						stats.count(S::RELAXATIONS);
 						if (!e->t->inq) {
 							e->t->inq = true;
 							q.push(e->t);
+							stats.count(S::QUEUE_PUSHES);
 						}
 					}
 				}
@@ -154,8 +259,441 @@ public:
 
 			flow += N[t].f;
 			cost += N[t].f * N[t].d;
+			stats.count(S::AUGMENTATIONS);
+		}
+	}
+
+private:
+	// Potentials `h` keep every residual edge's reduced cost non-negative
+	void primalDualPotential(Node *s, int n) {
+		bool negative = false;
+		for (int i = 0; i < n; i++) {
+			N[i].h = 0;
+			for (Edge *e = N[i].e; e; e = e->next) if (e->f < e->c && e->w < 0) negative = true;
+		}
+		if (!negative) return;
+
+		typename S::Scope scope(stats, S::SEARCH);
+
+		for (int i = 0; i < n; i++) {
+			N[i].inq = false;
+			N[i].h = MAX;
+		}
+
+		std::queue<Node *> q;
+
+		s->h = 0;
+		s->inq = true;
+		q.push(s);
+		stats.count(S::QUEUE_PUSHES);
+
+		while (!q.empty()) {
+			Node *v = q.front();
+			q.pop();
+
+			v->inq = false;
+
+			for (Edge *e = v->e; e; e = e->next) {
+				if (e->f < e->c && e->t->h > v->h + e->w) {
+					e->t->h = v->h + e->w;
+					stats.count(S::RELAXATIONS);
+					if (!e->t->inq) {
+						e->t->inq = true;
+						q.push(e->t);
+						stats.count(S::QUEUE_PUSHES);
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < n; i++) if (N[i].h == MAX) N[i].h = 0;
+	}
+
+	bool primalDualDijkstra(Node *s, Node *t, int n) {
+		typename S::Scope scope(stats, S::SEARCH);
+		stats.count(S::PHASES);
+
+		for (int i = 0; i < n; i++) N[i].d = MAX;
+
+		std::priority_queue< std::pair<T, Node *> > q;
+
+		s->d = 0;
+		q.push(std::make_pair(0, s));
+		stats.count(S::QUEUE_PUSHES);
+
+		while (!q.empty()) {
+			std::pair<T, Node *> p = q.top();
+			q.pop();
+
+			Node *v = p.second;
+
+			if (-v->d != p.first) continue;
+			if (v == t) break;
+
+			for (Edge *e = v->e; e; e = e->next) {
+				if (e->f < e->c) {
+					T d = v->d + e->w + v->h - e->t->h;
+					if (e->t->d > d) {
+						e->t->d = d;
+						q.push(std::make_pair(-d, e->t));
+						stats.count(S::RELAXATIONS);
+						stats.count(S::QUEUE_PUSHES);
+					}
+				}
+			}
+		}
+
+		if (t->d == MAX) return false;
+
+		// Nodes not settled before `t` are at least as far as `t`
+		for (int i = 0; i < n; i++) N[i].h += std::min(N[i].d, t->d);
+		return true;
+	}
+
+	// Multi-path augmentation on the zero reduced cost subgraph, use var `inq` for visited
+	T primalDualFind(Node *v, Node *t, T limit) {
+		if (v == t) return limit;
+
+		v->inq = true;
+
+		T res = 0;
+		for (Edge *e = v->e; e; e = e->next) {
+			if (e->f < e->c && !e->t->inq && e->t->h == v->h + e->w) {
+				T f = primalDualFind(e->t, t, std::min(limit - res, e->c - e->f));
+				if (f) {
+					e->f += f;
+					e->r->f -= f;
+					res += f;
+					if (res == limit) break;
+				}
+			}
+		}
+
+		return res;
+	}
+
+public:
+	// Min cost max flow with Dijkstra on reduced costs, pushing several paths per phase
+	void primaldual(int s, int t, int n, T &flow, T &cost) {
+		stats.reset();
+		typename S::Scope scope(stats, S::TOTAL);
+
+		flow = cost = 0;
+		primalDualPotential(&N[s], n);
+		while (primalDualDijkstra(&N[s], &N[t], n)) {
+			typename S::Scope augment(stats, S::AUGMENT);
+			T f;
+			do {
+				for (int i = 0; i < n; i++) N[i].inq = false;
+				f = primalDualFind(&N[s], &N[t], MAX);
+				flow += f;
+				cost += f * (N[t].h - N[s].h);
+				if (f) stats.count(S::AUGMENTATIONS);
+			} while (f);
 		}
 	}
+
+private:
+	struct Barrier {
+		std::mutex m;
+		std::condition_variable cv;
+		unsigned n, count, generation;
+
+		Barrier(unsigned n) : n(n), count(0), generation(0) {}
+
+		void wait() {
+			std::unique_lock<std::mutex> lock(m);
+			unsigned g = generation;
+			if (++count == n) {
+				count = 0;
+				generation++;
+				cv.notify_all();
+			} else {
+				while (g == generation) cv.wait(lock);
+			}
+		}
+	};
+
+	// Synchronous push-relabel after Baumstark, Blelloch and Shun: every round discharges all
+	// active vertices in parallel against the labels of the previous round, and a push between
+	// two active vertices is only taken by the winner, so each residual pair has a single writer
+	struct PushRelabel {
+		const static int CHUNK = 64;
+
+		int n, m;
+		unsigned threads;
+		std::vector<int> head, to, rev;
+		std::unique_ptr< std::atomic<T>[] > cf, added;
+		std::unique_ptr< std::atomic<int>[] > label;
+		std::unique_ptr< std::atomic<bool>[] > queued;
+		std::vector<int> newLabel, cur, frontier;
+		std::vector<T> excess;
+		std::vector<char> active;
+		std::vector< std::vector<int> > next;
+		std::atomic<size_t> cursor;
+		std::atomic<long long> work, pushes;
+		Barrier barrier;
+		S &stats;
+		int sink, excluded, cap;
+		bool pending, done;
+
+		PushRelabel(int n, int m, unsigned threads, S &stats) : n(n), m(m), threads(threads), head(n + 1), to(m), rev(m),
+			cf(new std::atomic<T>[m]), added(new std::atomic<T>[n]), label(new std::atomic<int>[n]), queued(new std::atomic<bool>[n]),
+			newLabel(n), excess(n), active(n), next(threads), cursor(0), work(0), pushes(0), barrier(threads), stats(stats) {
+			for (int i = 0; i < n; i++) {
+				added[i].store(0, std::memory_order_relaxed);
+				label[i].store(0, std::memory_order_relaxed);
+				queued[i].store(false, std::memory_order_relaxed);
+			}
+		}
+
+		static void atomicAdd(std::atomic<T> &x, T d) {
+			T o = x.load(std::memory_order_relaxed);
+			while (!x.compare_exchange_weak(o, o + d, std::memory_order_relaxed));
+		}
+
+		size_t part(size_t size, unsigned id) {
+			return size * id / threads;
+		}
+
+		bool isActive(int v) {
+			return excess[v] > 0 && label[v].load(std::memory_order_relaxed) < cap && v != sink && v != excluded;
+		}
+
+		// `v` takes the push on (v, w) when both of them are active
+		bool win(int v, int w) {
+			int dv = label[v].load(std::memory_order_relaxed), dw = label[w].load(std::memory_order_relaxed);
+			return dv == dw + 1 || dv < dw - 1 || (dv == dw && v < w);
+		}
+
+		long long discharge(int v, std::vector<int> &out, long long &pushed) {
+			T e = excess[v];
+			int d = label[v].load(std::memory_order_relaxed);
+			long long w = 0;
+
+			while (e > 0) {
+				int l = cap;
+				bool skipped = false;
+
+				for (int a = head[v]; a < head[v + 1]; a++) {
+					T r = cf[a].load(std::memory_order_relaxed);
+					if (!(r > 0)) continue;
+
+					int u = to[a], du = label[u].load(std::memory_order_relaxed);
+					if (d != du + 1) {
+						l = std::min(l, du + 1);
+						continue;
+					}
+
+					if (active[u] && !win(v, u)) {
+						skipped = true;
+						continue;
+					}
+
+					T f = std::min(r, e);
+					cf[a].store(r - f, std::memory_order_relaxed);
+					cf[rev[a]].store(cf[rev[a]].load(std::memory_order_relaxed) + f, std::memory_order_relaxed);
+					atomicAdd(added[u], f);
+					if (!queued[u].exchange(true, std::memory_order_relaxed)) out.push_back(u);
+					if (S::ENABLED) pushed++;
+
+					e -= f;
+					if (!(e > 0)) break;
+				}
+
+				w += head[v + 1] - head[v] + 1;
+				if (!(e > 0) || skipped) break;
+
+				d = l;
+				if (d >= cap) break;
+			}
+
+			excess[v] = e;
+			newLabel[v] = d;
+			if (e > 0 && !queued[v].exchange(true, std::memory_order_relaxed)) out.push_back(v);
+
+			return w;
+		}
+
+		void merge() {
+			for (size_t i = 0; i < cur.size(); i++) active[cur[i]] = false;
+			cur.clear();
+			for (unsigned i = 0; i < threads; i++) {
+				for (size_t j = 0; j < next[i].size(); j++) {
+					if (isActive(next[i][j])) {
+						cur.push_back(next[i][j]);
+						active[next[i][j]] = true;
+					}
+				}
+				next[i].clear();
+			}
+			cursor = 0;
+		}
+
+		// Parallel BFS from the sink over the reverse residual graph
+		void globalRelabel(unsigned id) {
+			for (int v = part(n, id), r = part(n, id + 1); v < r; v++) label[v].store(cap, std::memory_order_relaxed);
+			barrier.wait();
+
+			if (id == 0) {
+				label[sink].store(0, std::memory_order_relaxed);
+				frontier.assign(1, sink);
+				cursor = 0;
+			}
+			barrier.wait();
+
+			while (!frontier.empty()) {
+				for (size_t i; (i = cursor.fetch_add(CHUNK)) < frontier.size(); ) {
+					for (size_t j = i; j < std::min(i + CHUNK, frontier.size()); j++) {
+						int u = frontier[j], du = label[u].load(std::memory_order_relaxed);
+						for (int a = head[u]; a < head[u + 1]; a++) {
+							int v = to[a], expected = cap;
+							if (v != excluded && cf[rev[a]].load(std::memory_order_relaxed) > 0
+								&& label[v].load(std::memory_order_relaxed) == cap
+								&& label[v].compare_exchange_strong(expected, du + 1, std::memory_order_relaxed)) {
+								next[id].push_back(v);
+							}
+						}
+					}
+				}
+				barrier.wait();
+
+				if (id == 0) {
+					frontier.clear();
+					for (unsigned i = 0; i < threads; i++) {
+						frontier.insert(frontier.end(), next[i].begin(), next[i].end());
+						next[i].clear();
+					}
+					cursor = 0;
+				}
+				barrier.wait();
+			}
+
+			for (int v = part(n, id), r = part(n, id + 1); v < r; v++) {
+				if (isActive(v)) next[id].push_back(v);
+			}
+			barrier.wait();
+
+			if (id == 0) {
+				merge();
+				work = 0;
+				done = cur.empty();
+			}
+			barrier.wait();
+		}
+
+		// Thread 0 speaks for all of them in the stats, the other threads only add their pushes
+		void relabel(unsigned id) {
+			if (id) return globalRelabel(id);
+
+			typename S::Scope scope(stats, S::RELABEL);
+			stats.count(S::RELABELS);
+			globalRelabel(id);
+		}
+
+		void solve(unsigned id) {
+			relabel(id);
+
+			while (!done) {
+				long long w = 0, p = 0;
+				for (size_t i; (i = cursor.fetch_add(CHUNK)) < cur.size(); ) {
+					for (size_t j = i; j < std::min(i + CHUNK, cur.size()); j++) w += discharge(cur[j], next[id], p);
+				}
+				work += w;
+				if (S::ENABLED) pushes += p;
+				if (id == 0) stats.count(S::PHASES);
+				barrier.wait();
+
+				for (size_t i = part(cur.size(), id), r = part(cur.size(), id + 1); i < r; i++) {
+					label[cur[i]].store(newLabel[cur[i]], std::memory_order_relaxed);
+				}
+				for (size_t i = 0; i < next[id].size(); i++) {
+					int v = next[id][i];
+					excess[v] += added[v].exchange(0, std::memory_order_relaxed);
+					queued[v].store(false, std::memory_order_relaxed);
+				}
+				barrier.wait();
+
+				if (id == 0) {
+					merge();
+					pending = cur.empty() || work > 6ll * n + m;
+				}
+				barrier.wait();
+
+				// Labels may have drifted, so the run only stops once a fresh global relabel agrees
+				if (pending) relabel(id);
+			}
+		}
+
+		void run(unsigned id, int s, int t) {
+			solve(id);
+			barrier.wait();
+
+			// Return the excess stuck behind the min cut to the source
+			if (id == 0) {
+				sink = s;
+				excluded = t;
+				cap = 2 * n;
+			}
+			barrier.wait();
+
+			solve(id);
+		}
+	};
+
+public:
+	// Multi-threaded push-relabel, `threads` defaults to the hardware concurrency
+	T pushrelabel(int s, int t, int n, unsigned threads = 0) {
+		stats.reset();
+		typename S::Scope scope(stats, S::TOTAL);
+
+		if (!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+
+		int m = 0;
+		for (int i = 0; i < n; i++) for (Edge *e = N[i].e; e; e = e->next) m++;
+
+		PushRelabel p(n, m, threads, stats);
+		std::vector<int> pos(E.size());
+
+		for (int i = 0, a = 0; i < n; i++) {
+			p.head[i] = a;
+			for (Edge *e = N[i].e; e; e = e->next, a++) {
+				pos[e->i] = a;
+				p.to[a] = e->t - N;
+				p.cf[a].store(e->c - e->f, std::memory_order_relaxed);
+			}
+		}
+		p.head[n] = m;
+		for (int i = 0, a = 0; i < n; i++) {
+			for (Edge *e = N[i].e; e; e = e->next, a++) p.rev[a] = pos[e->r->i];
+		}
+
+		// Saturate the source edges, a self-loop on s would only end up with phantom flow
+		for (int a = p.head[s]; a < p.head[s + 1]; a++) {
+			T f = p.cf[a].load(std::memory_order_relaxed);
+			if (f > 0 && p.to[a] != s) {
+				p.cf[a].store(0, std::memory_order_relaxed);
+				p.cf[p.rev[a]].store(p.cf[p.rev[a]].load(std::memory_order_relaxed) + f, std::memory_order_relaxed);
+				p.excess[p.to[a]] += f;
+			}
+		}
+
+		p.sink = t;
+		p.excluded = s;
+		p.cap = n;
+
+		std::vector<std::thread> workers;
+		for (unsigned i = 1; i < threads; i++) workers.push_back(std::thread(&PushRelabel::run, &p, i, s, t));
+		p.run(0, s, t);
+		for (unsigned i = 0; i < workers.size(); i++) workers[i].join();
+		stats.count(S::PUSHES, p.pushes);
+
+		for (int i = 0, a = 0; i < n; i++) {
+			for (Edge *e = N[i].e; e; e = e->next, a++) e->f = e->c - p.cf[a].load(std::memory_order_relaxed);
+		}
+
+		return p.excess[t];
+	}
 };
 
 }
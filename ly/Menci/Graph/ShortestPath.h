@@ -4,11 +4,14 @@
 #include <climits>
 #include <queue>
 
+#include "../../Utility/Stats.h"
+
 namespace ly {
 namespace Menci {
 namespace Graph {
 
-template <int MAXN, typename T = int, T MAX = INT_MAX>
+// `S` is Utility::Stats to count relaxations and queue pushes per call, Utility::NoStats costs nothing
+template <int MAXN, typename T = int, T MAX = INT_MAX, typename S = Utility::DefaultStats>
 struct ShortestPath {
 private:
 	struct Node;
@@ -29,6 +32,8 @@ private:
 	};
 
 public:
+	S stats;
+
 	inline void addEdge(int s, int t, T w = 1, bool rev = false) {
 		N[s].e = new Edge(&N[s], &N[t], w);
 		if (rev) N[t].e = new Edge(&N[t], &N[s], w);
@@ -49,6 +54,9 @@ public:
 	}
 
 	inline T spfa(int s, int t = -1) {
+		stats.reset();
+		typename S::Scope scope(stats, S::TOTAL);
+
 		reset();
 
 		std::queue<Node *> q;
@@ -56,6 +64,7 @@ public:
 		N[s].d = 0;
 		N[s].inq = true;
 		q.push(&N[s]);
+		stats.count(S::QUEUE_PUSHES);
 
 		while (!q.empty()) {
 			Node *v = q.front();
@@ -66,9 +75,11 @@ public:
 			for (Edge *e = v->e; e; e = e->next) {
 				if (e->t->d > v->d + e->w) {
 					e->t->d = v->d + e->w;
+					stats.count(S::RELAXATIONS);
 					if (!e->t->inq) {
 						e->t->inq = true;
 						q.push(e->t);
+						stats.count(S::QUEUE_PUSHES);
 					}
 				}
 			}
@@ -79,12 +90,16 @@ public:
 	}
 
 	inline T dijkstra(int s, int t = -1) {
+		stats.reset();
+		typename S::Scope scope(stats, S::TOTAL);
+
 		reset();
 
 		std::priority_queue< std::pair<T, Node *> > q;
 
 		N[s].d = 0;
 		q.push(std::make_pair(0, &N[s]));
+		stats.count(S::QUEUE_PUSHES);
 
 		while (!q.empty()) {
 			std::pair<T, Node *> p = q.top();
@@ -99,6 +114,8 @@ public:
 				if (e->t->d > v->d + e->w) {
 					e->t->d = v->d + e->w;
 					q.push(std::make_pair(-e->t->d, e->t));
+					stats.count(S::RELAXATIONS);
+					stats.count(S::QUEUE_PUSHES);
 				}
 			}
 		}
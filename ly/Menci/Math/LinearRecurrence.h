@@ -0,0 +1,130 @@
+#ifndef _LY_MENCI_MATH_LINEARRECURRENCE_H
+#define _LY_MENCI_MATH_LINEARRECURRENCE_H
+
+#include <algorithm>
+#include <vector>
+
+#include "Polynomial.h"
+
+namespace ly {
+namespace Menci {
+namespace Math {
+
+// Shortest c with s[i] = c[0] s[i - 1] + ... + c[L - 1] s[i - L] for every i >= L, over a prime field.
+// 2L terms of the sequence are enough to recover a recurrence of order L.
+template <typename M>
+inline std::vector<M> berlekampMassey(const std::vector<M> &s) {
+	std::vector<M> c(1, M(1)), b(1, M(1));
+	size_t l = 0, shift = 1;
+	M last = M(1);
+
+	for (size_t n = 0; n < s.size(); n++, shift++) {
+		M d = s[n];
+		for (size_t i = 1; i <= l; i++) d += c[i] * s[n - i];
+		if (d == M(0)) continue;
+
+		std::vector<M> t = c;
+		M k = d / last;
+		if (c.size() < b.size() + shift) c.resize(b.size() + shift);
+		for (size_t i = 0; i < b.size(); i++) c[i + shift] -= k * b[i];
+
+		if (2 * l <= n) {
+			l = n + 1 - l;
+			b = t;
+			last = d;
+			shift = 0;
+		}
+	}
+
+	std::vector<M> res(l);
+	for (size_t i = 0; i < l; i++) res[i] = -c[i + 1];
+	return res;
+}
+
+// n-th term of a(i) = c[0] a(i - 1) + ... + c[k - 1] a(i - k) as the dot product of x^n mod f with the first k terms,
+// where f is the characteristic polynomial (Kitamasa). O(k log k log n) with fast multiplication and division,
+// short recurrences use the O(k^2) schoolbook versions which win at that size.
+template <typename M>
+struct LinearRecurrence {
+private:
+	const static size_t SCHOOLBOOK = 64;
+
+	size_t k;
+	std::vector<M> a;
+	// Monic characteristic polynomial, and the inverse of its reversal for the quotient by Newton's method
+	Polynomial<M> f, rf;
+
+	Polynomial<M> multiply(const Polynomial<M> &x, const Polynomial<M> &y) const {
+		if (k > SCHOOLBOOK) return x * y;
+
+		Polynomial<M> res(x.size() + y.size() - 1);
+		for (size_t i = 0; i < x.size(); i++) for (size_t j = 0; j < y.size(); j++) res[i + j] += x[i] * y[j];
+		return res;
+	}
+
+	// g mod f for deg g <= 2k - 2
+	Polynomial<M> reduce(Polynomial<M> g) const {
+		if (g.size() <= k) return g;
+
+		if (k <= SCHOOLBOOK) {
+			for (size_t i = g.size() - 1; i >= k; i--) {
+				M t = g[i];
+				if (t == M(0)) continue;
+				for (size_t j = 0; j < k; j++) g[i - k + j] -= t * f[j];
+			}
+			return g.truncate(k);
+		}
+
+		size_t n = g.size() - k;
+		Polynomial<M> rg(g.rbegin(), g.rend());
+		Polynomial<M> q = (rg.truncate(n) * rf.truncate(n)).truncate(n);
+		std::reverse(q.begin(), q.end());
+		return (g - q * f).truncate(k);
+	}
+
+	Polynomial<M> multiplyByX(Polynomial<M> g) const {
+		g.insert(g.begin(), M(0));
+		if (g.size() > k) {
+			M t = g[k];
+			for (size_t j = 0; j < k; j++) g[j] -= t * f[j];
+			g.resize(k);
+		}
+		return g;
+	}
+
+public:
+	// `init` holds at least the first k = c.size() terms
+	LinearRecurrence(const std::vector<M> &init, const std::vector<M> &c) : k(c.size()), a(init.begin(), init.begin() + c.size()), f(c.size() + 1) {
+		f[k] = M(1);
+		for (size_t i = 0; i < k; i++) f[k - 1 - i] = -c[i];
+		if (k > SCHOOLBOOK) rf = Polynomial<M>(f.rbegin(), f.rend()).inv(k);
+	}
+
+	M operator()(unsigned long long n) const {
+		if (k == 0) return M(0);
+		if (n < k) return a[n];
+
+		Polynomial<M> r(1, M(1));
+		for (int i = 63 - __builtin_clzll(n); i >= 0; i--) {
+			r = reduce(multiply(r, r));
+			if (n >> i & 1) r = multiplyByX(r);
+		}
+
+		M res;
+		for (size_t i = 0; i < r.size(); i++) res += r[i] * a[i];
+		return res;
+	}
+};
+
+// n-th term of a sequence given enough leading terms to determine its recurrence
+template <typename M>
+inline M nthTerm(const std::vector<M> &s, unsigned long long n) {
+	if (n < s.size()) return s[n];
+	return LinearRecurrence<M>(s, berlekampMassey(s))(n);
+}
+
+}
+}
+}
+
+#endif // _LY_MENCI_MATH_LINEARRECURRENCE_H
@@ -0,0 +1,125 @@
+#ifndef _LY_MENCI_MATH_MATRIX_H
+#define _LY_MENCI_MATH_MATRIX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ly {
+namespace Menci {
+namespace Math {
+
+// Dense row-major matrix over Z / mod for any runtime modulus below 2^64, entries are kept in [0, mod).
+// Products are cache blocked and every dot product is accumulated exactly in 128 bits, then reduced once.
+struct ModMatrix {
+	size_t n, m;
+	uint64_t mod;
+	std::vector<uint64_t> a;
+
+	ModMatrix(size_t n, size_t m, uint64_t mod) : n(n), m(m), mod(mod), a(n * m) {}
+
+	static ModMatrix identity(size_t n, uint64_t mod) {
+		ModMatrix res(n, n, mod);
+		for (size_t i = 0; i < n; i++) res[i][i] = 1 % mod;
+		return res;
+	}
+
+	uint64_t *operator[](size_t i) {
+		return &a[i * m];
+	}
+
+	const uint64_t *operator[](size_t i) const {
+		return &a[i * m];
+	}
+
+private:
+	// An enumerator so std::min can take it by reference without an out-of-class definition
+	enum { BLOCK = 32 };
+
+	// An accumulator overflows 2^128 `carry` times, which only happens when mod >= 2^32
+	uint64_t reduce(unsigned __int128 acc, uint64_t carry) const {
+		if (!carry) return acc % mod;
+		uint64_t r64 = -mod % mod, r128 = (unsigned __int128)r64 * r64 % mod;
+		return ((unsigned __int128)carry * r128 + acc % mod) % mod;
+	}
+
+	// Below 2^32 a product fits in 64 bits and the sum of up to 2^64 of them never overflows
+	template <bool WIDE>
+	void multiply(const ModMatrix &o, ModMatrix &res) const {
+		unsigned __int128 acc[BLOCK][BLOCK];
+		uint64_t carry[BLOCK][BLOCK];
+
+		for (size_t i0 = 0; i0 < n; i0 += BLOCK) for (size_t j0 = 0; j0 < o.m; j0 += BLOCK) {
+			size_t ni = std::min<size_t>(BLOCK, n - i0), nj = std::min<size_t>(BLOCK, o.m - j0);
+			for (size_t i = 0; i < ni; i++) {
+				std::fill(acc[i], acc[i] + nj, 0);
+				std::fill(carry[i], carry[i] + nj, 0);
+			}
+
+			for (size_t k0 = 0; k0 < m; k0 += BLOCK) {
+				size_t nk = std::min<size_t>(BLOCK, m - k0);
+				for (size_t i = 0; i < ni; i++) {
+					const uint64_t *x = (*this)[i0 + i] + k0;
+					for (size_t k = 0; k < nk; k++) {
+						const uint64_t v = x[k], *y = o[k0 + k] + j0;
+						if (!v) continue;
+						for (size_t j = 0; j < nj; j++) {
+							if (WIDE) {
+								unsigned __int128 p = (unsigned __int128)v * y[j];
+								acc[i][j] += p;
+								carry[i][j] += acc[i][j] < p;
+							} else acc[i][j] += v * y[j];
+						}
+					}
+				}
+			}
+
+			for (size_t i = 0; i < ni; i++) for (size_t j = 0; j < nj; j++) res[i0 + i][j0 + j] = reduce(acc[i][j], carry[i][j]);
+		}
+	}
+
+public:
+	// The moduli must agree and the inner dimensions must match
+	friend ModMatrix operator*(const ModMatrix &a, const ModMatrix &b) {
+		ModMatrix res(a.n, b.m, a.mod);
+		if (a.mod >> 32) a.multiply<true>(b, res);
+		else a.multiply<false>(b, res);
+		return res;
+	}
+
+	ModMatrix &operator*=(const ModMatrix &o) {
+		return *this = *this * o;
+	}
+
+	std::vector<uint64_t> operator*(const std::vector<uint64_t> &v) const {
+		std::vector<uint64_t> res(n);
+		for (size_t i = 0; i < n; i++) {
+			const uint64_t *x = (*this)[i];
+			unsigned __int128 acc = 0;
+			uint64_t carry = 0;
+			for (size_t j = 0; j < m; j++) {
+				unsigned __int128 p = (unsigned __int128)x[j] * v[j];
+				acc += p;
+				carry += acc < p;
+			}
+			res[i] = reduce(acc, carry);
+		}
+		return res;
+	}
+
+	// Square matrices only
+	ModMatrix pow(unsigned long long e) const {
+		ModMatrix res = identity(n, mod), b = *this;
+		for (; e; e /= 2) {
+			if (e & 1) res *= b;
+			if (e > 1) b *= b;
+		}
+		return res;
+	}
+};
+
+}
+}
+}
+
+#endif // _LY_MENCI_MATH_MATRIX_H
@@ -0,0 +1,243 @@
+#ifndef _LY_MENCI_MATH_MODINT_H
+#define _LY_MENCI_MATH_MODINT_H
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace ly {
+namespace Menci {
+namespace Math {
+
+// Compile-time odd modulus, values are kept in Montgomery form x * 2^32 mod P
+template <uint32_t P>
+struct ModInt {
+	static_assert(P & 1, "Montgomery reduction needs an odd modulus");
+	static_assert(P < (1u << 31), "ModInt needs a modulus below 2^31");
+
+	// -P^-1 mod 2^32 by Newton's iteration, each step doubles the correct bits starting from 3
+	constexpr static uint32_t negInv(uint32_t y = P, int i = 4) {
+		return i == 0 ? -y : negInv(y * (2 - P * y), i - 1);
+	}
+
+	// -P^-1 mod 2^32, public for vectorised kernels working on the raw Montgomery words
+	const static uint32_t NEG_INV;
+
+private:
+	const static uint32_t R2;
+
+	uint32_t x;
+
+	static uint32_t reduce(uint64_t t) {
+		uint32_t r = (t + (uint64_t)((uint32_t)t * NEG_INV) * P) >> 32;
+		return r >= P ? r - P : r;
+	}
+
+public:
+	ModInt() : x(0) {}
+
+	template <typename I, typename std::enable_if<std::is_integral<I>::value && std::is_signed<I>::value, int>::type = 0>
+	ModInt(I v) {
+		long long y = v % (long long)P;
+		x = reduce((uint64_t)(y < 0 ? y + P : y) * R2);
+	}
+
+	template <typename I, typename std::enable_if<std::is_integral<I>::value && !std::is_signed<I>::value, int>::type = 0>
+	ModInt(I v) : x(reduce((uint64_t)(v % P) * R2)) {}
+
+	constexpr static uint32_t mod() {
+		return P;
+	}
+
+	uint32_t val() const {
+		return reduce(x);
+	}
+
+	ModInt &operator+=(const ModInt &o) {
+		x += o.x;
+		if (x >= P) x -= P;
+		return *this;
+	}
+
+	ModInt &operator-=(const ModInt &o) {
+		x = x >= o.x ? x - o.x : x + P - o.x;
+		return *this;
+	}
+
+	ModInt &operator*=(const ModInt &o) {
+		x = reduce((uint64_t)x * o.x);
+		return *this;
+	}
+
+	ModInt &operator/=(const ModInt &o) {
+		return *this *= o.inv();
+	}
+
+	ModInt operator-() const {
+		ModInt res;
+		res.x = x ? P - x : 0;
+		return res;
+	}
+
+	ModInt pow(unsigned long long b) const {
+		ModInt res(1), a = *this;
+		for (; b; b /= 2, a *= a) if (b & 1) res *= a;
+		return res;
+	}
+
+	// Extended Euclid, so P does not have to be prime as long as the value is coprime to it
+	ModInt inv() const {
+		long long a = val(), b = P, u = 1, v = 0;
+		while (b) {
+			long long t = a / b;
+			a -= t * b, std::swap(a, b);
+			u -= t * v, std::swap(u, v);
+		}
+		return ModInt(u);
+	}
+
+	friend ModInt operator+(ModInt a, const ModInt &b) { return a += b; }
+	friend ModInt operator-(ModInt a, const ModInt &b) { return a -= b; }
+	friend ModInt operator*(ModInt a, const ModInt &b) { return a *= b; }
+	friend ModInt operator/(ModInt a, const ModInt &b) { return a /= b; }
+	friend bool operator==(const ModInt &a, const ModInt &b) { return a.x == b.x; }
+	friend bool operator!=(const ModInt &a, const ModInt &b) { return a.x != b.x; }
+};
+
+template <uint32_t P> const uint32_t ModInt<P>::NEG_INV = ModInt<P>::negInv();
+template <uint32_t P> const uint32_t ModInt<P>::R2 = -(uint64_t)P % P;
+
+// Runtime modulus below 2^31 shared by every value with the same `ID`, reduced with Barrett's method
+template <int ID = 0>
+struct DynamicModInt {
+private:
+	static uint32_t m;
+	static uint64_t im;
+
+	uint32_t x;
+
+	static uint32_t reduce(uint64_t z) {
+		uint64_t q = (uint64_t)(((unsigned __int128)z * im) >> 64);
+		uint32_t r = z - q * m;
+		return m <= r ? r + m : r;
+	}
+
+public:
+	static void setMod(uint32_t p) {
+		m = p;
+		im = (uint64_t)-1 / p + 1;
+	}
+
+	static uint32_t mod() {
+		return m;
+	}
+
+	DynamicModInt() : x(0) {}
+
+	template <typename I, typename std::enable_if<std::is_integral<I>::value && std::is_signed<I>::value, int>::type = 0>
+	DynamicModInt(I v) {
+		long long y = v % (long long)m;
+		x = y < 0 ? y + m : y;
+	}
+
+	template <typename I, typename std::enable_if<std::is_integral<I>::value && !std::is_signed<I>::value, int>::type = 0>
+	DynamicModInt(I v) : x(v % m) {}
+
+	uint32_t val() const {
+		return x;
+	}
+
+	DynamicModInt &operator+=(const DynamicModInt &o) {
+		x += o.x;
+		if (x >= m) x -= m;
+		return *this;
+	}
+
+	DynamicModInt &operator-=(const DynamicModInt &o) {
+		x = x >= o.x ? x - o.x : x + m - o.x;
+		return *this;
+	}
+
+	DynamicModInt &operator*=(const DynamicModInt &o) {
+		x = reduce((uint64_t)x * o.x);
+		return *this;
+	}
+
+	DynamicModInt &operator/=(const DynamicModInt &o) {
+		return *this *= o.inv();
+	}
+
+	DynamicModInt operator-() const {
+		DynamicModInt res;
+		res.x = x ? m - x : 0;
+		return res;
+	}
+
+	DynamicModInt pow(unsigned long long b) const {
+		DynamicModInt res(1), a = *this;
+		for (; b; b /= 2, a *= a) if (b & 1) res *= a;
+		return res;
+	}
+
+	DynamicModInt inv() const {
+		long long a = x, b = m, u = 1, v = 0;
+		while (b) {
+			long long t = a / b;
+			a -= t * b, std::swap(a, b);
+			u -= t * v, std::swap(u, v);
+		}
+		return DynamicModInt(u);
+	}
+
+	friend DynamicModInt operator+(DynamicModInt a, const DynamicModInt &b) { return a += b; }
+	friend DynamicModInt operator-(DynamicModInt a, const DynamicModInt &b) { return a -= b; }
+	friend DynamicModInt operator*(DynamicModInt a, const DynamicModInt &b) { return a *= b; }
+	friend DynamicModInt operator/(DynamicModInt a, const DynamicModInt &b) { return a /= b; }
+	friend bool operator==(const DynamicModInt &a, const DynamicModInt &b) { return a.x == b.x; }
+	friend bool operator!=(const DynamicModInt &a, const DynamicModInt &b) { return a.x != b.x; }
+};
+
+template <int ID> uint32_t DynamicModInt<ID>::m = 998244353;
+template <int ID> uint64_t DynamicModInt<ID>::im = (uint64_t)-1 / 998244353 + 1;
+
+// Runtime odd 64-bit modulus for Montgomery multiplication, the whole range below 2^64 is supported
+struct Montgomery64 {
+	uint64_t n, ni, r2;
+
+	explicit Montgomery64(uint64_t n) : n(n), ni(n) {
+		for (int i = 0; i < 5; i++) ni *= 2 - n * ni;
+		uint64_t r = -n % n;
+		r2 = (unsigned __int128)r * r % n;
+	}
+
+	// t < n * 2^64, result in [0, n)
+	uint64_t reduce(unsigned __int128 t) const {
+		uint64_t h = ((unsigned __int128)((uint64_t)t * ni) * n) >> 64, hi = t >> 64;
+		return hi >= h ? hi - h : hi - h + n;
+	}
+
+	uint64_t mul(uint64_t a, uint64_t b) const {
+		return reduce((unsigned __int128)a * b);
+	}
+
+	uint64_t to(uint64_t x) const {
+		return mul(x % n, r2);
+	}
+
+	uint64_t from(uint64_t x) const {
+		return reduce(x);
+	}
+
+	// `a` and the result are in Montgomery form
+	uint64_t pow(uint64_t a, uint64_t b) const {
+		uint64_t res = to(1);
+		for (; b; b /= 2, a = mul(a, a)) if (b & 1) res = mul(res, a);
+		return res;
+	}
+};
+
+}
+}
+}
+
+#endif // _LY_MENCI_MATH_MODINT_H
@@ -1,31 +1,121 @@
 #ifndef _LY_MENCI_MATH_NUMBERTHEORY_H
 #define _LY_MENCI_MATH_NUMBERTHEORY_H
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "ModInt.h"
+#include "../DataStructure/HashTable.h"
 
 namespace ly {
 namespace Menci {
 namespace Math {
 namespace NumberTheory {
 
+inline int ctz(unsigned int x) { return __builtin_ctz(x); }
+inline int ctz(unsigned long x) { return __builtin_ctzl(x); }
+inline int ctz(unsigned long long x) { return __builtin_ctzll(x); }
+
+// Binary GCD, the next shift and the new pair are computed without branches so the iterations only depend on the subtraction
+template <typename U>
+inline U binaryGcd(U a, U b) {
+	if (!a) return b;
+	if (!b) return a;
+
+	int za = ctz(a), zb = ctz(b), s = za < zb ? za : zb;
+	b >>= zb;
+	while (a) {
+		a >>= za;
+		U d = b - a, m = -(U)(a > b);
+		// The top bit keeps ctz defined once a == b, which ends the loop anyway
+		za = ctz(d | U(1) << (sizeof(U) * 8 - 1));
+		b = a < b ? a : b;
+		a = (d ^ m) - m;
+	}
+	return b << s;
+}
+
+template <typename T>
+inline typename std::make_unsigned<T>::type magnitude(T a, std::true_type) {
+	typedef typename std::make_unsigned<T>::type U;
+	return a < 0 ? U(0) - U(a) : U(a);
+}
+
+template <typename T>
+inline T magnitude(T a, std::false_type) {
+	return a;
+}
+
+template <typename T>
+inline T gcd(T a, T b, std::true_type) {
+	// Narrow types are promoted first so ctz always sees one of its overloads
+	typedef decltype(a + 0) P;
+	std::is_signed<P> sign;
+	return binaryGcd(magnitude(P(a), sign), magnitude(P(b), sign));
+}
+
+template <typename T>
+inline T gcd(T a, T b, std::false_type) {
+	while (b) {
+		T t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+// Non-negative, binary for the built-in integers and Euclid's otherwise
 template <typename T>
 inline T gcd(T a, T b) {
-	return !b ? a : gcd(b, a % b);
+	return gcd(a, b, std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) <= sizeof(unsigned long long)>());
 }
 
 template <typename T>
 inline void exgcd(T a, T b, T &g, T &x, T &y) {
-	if (!b) g = a, x = 1, y = 0;
-	else exgcd(b, a % b, g, y, x), y = y - x * (a / b);
+	T x0 = 1, y0 = 0, x1 = 0, y1 = 1;
+	while (b) {
+		T q = a / b, t;
+		t = a - q * b, a = b, b = t;
+		t = x0 - q * x1, x0 = x1, x1 = t;
+		t = y0 - q * y1, y0 = y1, y1 = t;
+	}
+	g = a, x = x0, y = y0;
+}
+
+// Type wide enough to hold the product of two values below the modulus
+template <typename T> struct Wide { typedef T type; };
+template <> struct Wide<int> { typedef long long type; };
+template <> struct Wide<unsigned int> { typedef unsigned long long type; };
+template <> struct Wide<long> { typedef __int128 type; };
+template <> struct Wide<unsigned long> { typedef unsigned __int128 type; };
+template <> struct Wide<long long> { typedef __int128 type; };
+template <> struct Wide<unsigned long long> { typedef unsigned __int128 type; };
+
+template <typename T>
+inline T mulmod(T a, T b, T p) {
+	return static_cast<T>(static_cast<typename Wide<T>::type>(a) * b % p);
 }
 
 template <typename T>
 inline T pow(T a, T b, T p) {
 	T res = 1;
-	for (; b; b = b / 2, a = a * a % p) if (b & 1) res = res * a % p;
+	for (; b; b = b / 2, a = mulmod(a, a, p)) if (b & 1) res = mulmod(res, a, p);
 	return res;
 }
 
+template <uint32_t P>
+inline ModInt<P> pow(ModInt<P> a, unsigned long long b) {
+	return a.pow(b);
+}
+
+template <int ID>
+inline DynamicModInt<ID> pow(DynamicModInt<ID> a, unsigned long long b) {
+	return a.pow(b);
+}
+
 template <typename T>
 inline T inv(T a, T p) {
     T g, x, y;
@@ -33,35 +123,152 @@ inline T inv(T a, T p) {
     return ((x % p) + p) % p;
 }
 
-template <typename T, typename MapType>
+template <uint32_t P>
+inline ModInt<P> inv(ModInt<P> a) {
+	return a.inv();
+}
+
+template <int ID>
+inline DynamicModInt<ID> inv(DynamicModInt<ID> a) {
+	return a.inv();
+}
+
+// Montgomery's trick: res[i] = 1 / a[i] from one inversion and 3(n - 1) products, `a` and `res` must not overlap
+template <typename T>
+inline void batchInv(const T *a, T *res, size_t n, T p) {
+	if (!n) return;
+
+	res[0] = a[0];
+	for (size_t i = 1; i < n; i++) res[i] = mulmod(res[i - 1], a[i], p);
+
+	T t = inv(res[n - 1], p);
+	for (size_t i = n - 1; i > 0; i--) {
+		res[i] = mulmod(t, res[i - 1], p);
+		t = mulmod(t, a[i], p);
+	}
+	res[0] = t;
+}
+
+template <typename M>
+inline void batchInv(const M *a, M *res, size_t n) {
+	if (!n) return;
+
+	res[0] = a[0];
+	for (size_t i = 1; i < n; i++) res[i] = res[i - 1] * a[i];
+
+	M t = res[n - 1].inv();
+	for (size_t i = n - 1; i > 0; i--) {
+		res[i] = t * res[i - 1];
+		t *= a[i];
+	}
+	res[0] = t;
+}
+
+// fac[i] = i! and ifac[i] = 1 / i! for i <= n with a single inversion, `n` must be below the prime `p`
+template <typename T>
+inline void factorials(int n, T p, std::vector<T> &fac, std::vector<T> &ifac) {
+	fac.resize(n + 1);
+	ifac.resize(n + 1);
+
+	fac[0] = 1 % p;
+	for (int i = 1; i <= n; i++) fac[i] = mulmod(fac[i - 1], T(i), p);
+
+	ifac[n] = inv(fac[n], p);
+	for (int i = n; i > 0; i--) ifac[i - 1] = mulmod(ifac[i], T(i), p);
+}
+
+template <typename M>
+inline void factorials(int n, std::vector<M> &fac, std::vector<M> &ifac) {
+	fac.resize(n + 1);
+	ifac.resize(n + 1);
+
+	fac[0] = M(1);
+	for (int i = 1; i <= n; i++) fac[i] = fac[i - 1] * M(i);
+
+	ifac[n] = fac[n].inv();
+	for (int i = n; i > 0; i--) ifac[i - 1] = ifac[i] * M(i);
+}
+
+// Pre-sizes hash maps, ordered maps have no reserve and are left alone
+template <typename MapType>
+inline auto reserveMap(MapType &map, size_t n, int) -> decltype(map.reserve(n), void()) {
+	map.reserve(n);
+}
+
+template <typename MapType>
+inline void reserveMap(MapType &, size_t, long) {}
+
+// `MapType` needs std::map style `insert` and `find`, and is pre-sized for the baby steps when it has `reserve`
+template <typename T, typename MapType = DataStructure::HashTable<T, T> >
 inline T bsgs(T a, T b, T p) {
     if (a == 0) return b == 0 ? 1 : -1;
 
+    T m = ceil(sqrt(p)), t = 1;
     MapType map;
+    reserveMap(map, m, 0);
 
-    T m = ceil(sqrt(p)), t = 1;
-    for (int i = 0; i < m; i++) {
-        if (!map.count(t)) map[t] = i;
-        t = t * a % p;
+    for (T i = 0; i < m; i++) {
+        map.insert(std::make_pair(t, i));
+        t = mulmod(t, a, p);
     }
 
     T k = inv(t, p), w = b;
-    for (int i = 0; i < m; i++) {
-        if (map.count(w)) return i * m + map[w];
-        w = w * k % p;
+    for (T i = 0; i < m; i++) {
+        typename MapType::iterator it = map.find(w);
+        if (it != map.end()) return i * m + it->second;
+        w = mulmod(w, k, p);
     }
 
     return -1;
 }
 
-template <typename T, typename MapType>
+// Baby-step giant-step with the table for a fixed base and modulus built once. With `queries` expected
+// lookups the baby steps grow to sqrt(p * queries), so building and answering cost about the same in total.
+template <typename T>
+struct DiscreteLog {
+private:
+	T a, p, m, g, k;
+	DataStructure::HashTable<T, T> table;
+
+public:
+	// `a` must be coprime to `p`
+	DiscreteLog(T a, T p, T queries = 1) : a(a % p), p(p) {
+		m = ceil(sqrt((double)p * queries));
+		if (m > p) m = p;
+		if (m < 1) m = 1;
+		g = (p + m - 1) / m;
+
+		table.reserve(m);
+
+		T t = 1 % p;
+		for (T i = 0; i < m; i++) {
+			table.insert(std::make_pair(t, i));
+			t = mulmod(t, this->a, p);
+		}
+		k = inv(t, p);
+	}
+
+	// Smallest x >= 0 with a^x = b (mod p), or -1
+	T log(T b) {
+		T w = b % p;
+		if (w < 0) w += p;
+		for (T i = 0; i < g; i++) {
+			typename DataStructure::HashTable<T, T>::iterator it = table.find(w);
+			if (it != table.end()) return i * m + it->second;
+			w = mulmod(w, k, p);
+		}
+		return -1;
+	}
+};
+
+template <typename T, typename MapType = DataStructure::HashTable<T, T> >
 inline T exbsgs(T a, T b, T p) {
     T t, c = 0;
     while ((t = gcd(a, p)) != 1) {
         if (b == 1) return c;
         if (b % t != 0) return -1;
         p /= t;
-        b = b / t * inv(a / t, p) % p;
+        b = mulmod(b / t, inv(a / t, p), p);
         c++;
     }
 
@@ -70,13 +277,270 @@ inline T exbsgs(T a, T b, T p) {
     else return r + c;
 }
 
+template <typename MapType = DataStructure::HashTable<long long, long long>, uint32_t P>
+inline long long bsgs(ModInt<P> a, ModInt<P> b) {
+	return bsgs<long long, MapType>(a.val(), b.val(), P);
+}
+
+template <typename MapType = DataStructure::HashTable<long long, long long>, int ID>
+inline long long bsgs(DynamicModInt<ID> a, DynamicModInt<ID> b) {
+	return bsgs<long long, MapType>(a.val(), b.val(), DynamicModInt<ID>::mod());
+}
+
+constexpr unsigned SMALL_PRIMES[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47 };
+constexpr unsigned SMALL_PRIMES_BOUND = 53 * 53;
+
+// Bases that make Miller-Rabin deterministic below 2^64 (Jim Sinclair)
+constexpr uint64_t MILLER_RABIN_BASES[] = { 2, 325, 9375, 28178, 450775, 9780504, 1795265022 };
+
+// 0 for composite, 1 for prime, -1 when Miller-Rabin has to decide
 template <typename T>
-inline bool isPrime(T x) {
-	if (x > -2 && x < 2) return false;
-	for (T i = 2; i * i <= x; i++) if (x % i == 0) return false;
+inline int trialDivide(T x) {
+	if (x < 2) return 0;
+	for (unsigned i = 0; i < sizeof(SMALL_PRIMES) / sizeof(SMALL_PRIMES[0]); i++) {
+		if (x == T(SMALL_PRIMES[i])) return 1;
+		if (x % T(SMALL_PRIMES[i]) == 0) return 0;
+	}
+	return x < T(SMALL_PRIMES_BOUND) ? 1 : -1;
+}
+
+// Strong probable prime test of odd `n` to base `a` in Montgomery form
+inline bool millerRabin(const Montgomery64 &mg, uint64_t a) {
+	uint64_t d = mg.n - 1, one = mg.to(1), minusOne = mg.to(mg.n - 1);
+	int s = __builtin_ctzll(d);
+	d >>= s;
+
+	uint64_t x = mg.pow(a, d);
+	if (x == one || x == minusOne) return true;
+	while (--s) {
+		x = mg.mul(x, x);
+		if (x == minusOne) return true;
+	}
+	return false;
+}
+
+// Deterministic below 2^64, even `n` is answered directly since Montgomery form needs an odd modulus
+inline bool millerRabin(uint64_t n) {
+	if (n < 3 || n % 2 == 0) return n == 2;
+
+	Montgomery64 mg(n);
+	for (unsigned i = 0; i < sizeof(MILLER_RABIN_BASES) / sizeof(MILLER_RABIN_BASES[0]); i++) {
+		uint64_t a = MILLER_RABIN_BASES[i] % n;
+		if (a && !millerRabin(mg, mg.to(a))) return false;
+	}
 	return true;
 }
 
+// Deterministic for every value below 2^64, larger ones fall back to trial division
+template <typename T>
+inline bool isPrime(T x) {
+	int r = trialDivide(x);
+	if (r != -1) return r;
+
+	if (sizeof(T) > sizeof(uint64_t) && x > T(~0ull)) {
+		for (T i = 2; i * i <= x; i++) if (x % i == 0) return false;
+		return true;
+	}
+	return millerRabin(static_cast<uint64_t>(x));
+}
+
+// Tests `n` values at once, running the exponentiations of four candidates interleaved so their
+// independent multiply chains overlap in the pipeline. Each base only runs on the survivors of the previous one.
+template <typename T>
+inline void isPrime(const T *x, bool *res, size_t n) {
+	const static int LANES = 4;
+
+	std::vector<size_t> rest;
+	std::vector<Montgomery64> mg;
+	for (size_t i = 0; i < n; i++) {
+		int r = trialDivide(x[i]);
+		if (r != -1) {
+			res[i] = r;
+		} else if (sizeof(T) > sizeof(uint64_t) && x[i] > T(~0ull)) {
+			res[i] = isPrime(x[i]);
+		} else {
+			res[i] = true;
+			rest.push_back(i);
+			mg.push_back(Montgomery64(x[i]));
+		}
+	}
+
+	for (unsigned b = 0; b < sizeof(MILLER_RABIN_BASES) / sizeof(MILLER_RABIN_BASES[0]) && !rest.empty(); b++) {
+		size_t survivors = 0;
+		for (size_t k = 0; k < rest.size(); k += LANES) {
+			const Montgomery64 *m[LANES];
+			uint64_t a[LANES], d[LANES], r[LANES], one[LANES];
+			int s[LANES], bits = 0;
+
+			for (int j = 0; j < LANES; j++) {
+				m[j] = &mg[std::min(k + j, rest.size() - 1)];
+				d[j] = m[j]->n - 1;
+				s[j] = __builtin_ctzll(d[j]);
+				d[j] >>= s[j];
+				bits = std::max(bits, 64 - __builtin_clzll(d[j]));
+				a[j] = m[j]->to(MILLER_RABIN_BASES[b] % m[j]->n);
+				r[j] = one[j] = m[j]->to(1);
+			}
+
+			for (int i = bits - 1; i >= 0; i--) {
+				for (int j = 0; j < LANES; j++) {
+					r[j] = m[j]->mul(r[j], r[j]);
+					uint64_t t = m[j]->mul(r[j], a[j]);
+					r[j] = d[j] >> i & 1 ? t : r[j];
+				}
+			}
+
+			for (int j = 0; j < LANES && k + j < rest.size(); j++) {
+				uint64_t minusOne = m[j]->n - one[j];
+				bool ok = !a[j] || r[j] == one[j] || r[j] == minusOne;
+				for (int i = 1; i < s[j] && !ok; i++) {
+					r[j] = m[j]->mul(r[j], r[j]);
+					ok = r[j] == minusOne;
+				}
+
+				if (ok) {
+					rest[survivors] = rest[k + j];
+					mg[survivors++] = mg[k + j];
+				} else {
+					res[rest[k + j]] = false;
+				}
+			}
+		}
+		rest.resize(survivors);
+		mg.erase(mg.begin() + survivors, mg.end());
+	}
+}
+
+// Pollard's rho with Brent's cycle detection on odd composite `n`, the differences are multiplied together
+// and only every `BATCH` steps fed to gcd, backtracking from the last saved point if the batch overshoots
+inline uint64_t pollardBrent(uint64_t n) {
+	const static uint64_t BATCH = 128;
+
+	Montgomery64 mg(n);
+	for (uint64_t c = 1; ; c++) {
+		uint64_t k = mg.to(c);
+		auto f = [&](uint64_t v) {
+			uint64_t w = mg.mul(v, v), r = w + k;
+			return r >= n || r < w ? r - n : r;
+		};
+
+		uint64_t x, y = mg.to(2), ys = y, q = mg.to(1), g = 1;
+		for (uint64_t r = 1; g == 1; r *= 2) {
+			x = y;
+			for (uint64_t i = 0; i < r; i++) y = f(y);
+			for (uint64_t i = 0; i < r && g == 1; i += BATCH) {
+				ys = y;
+				for (uint64_t j = 0; j < BATCH && i + j < r; j++) {
+					y = f(y);
+					q = mg.mul(q, x > y ? x - y : y - x);
+				}
+				g = gcd(q, n);
+			}
+		}
+
+		if (g == n) {
+			do {
+				ys = f(ys);
+				g = gcd(x > ys ? x - ys : ys - x, n);
+			} while (g == 1);
+		}
+
+		if (g != n) return g;
+	}
+}
+
+// Appends the prime factors of `n` with multiplicity in no particular order, factors of 2 are
+// taken out first so Pollard's rho only ever sees odd composites
+inline void factorize(uint64_t n, std::vector<uint64_t> &res) {
+	if (n == 0) return;
+	for (; n % 2 == 0; n /= 2) res.push_back(2);
+	if (n == 1) return;
+	if (millerRabin(n)) {
+		res.push_back(n);
+		return;
+	}
+
+	uint64_t d = pollardBrent(n);
+	factorize(d, res);
+	factorize(n / d, res);
+}
+
+// Prime factors with their exponents in increasing order
+template <typename T>
+inline std::vector< std::pair<T, int> > factorize(T n) {
+	std::vector< std::pair<T, int> > res;
+	if (n < 2) return res;
+
+	for (unsigned i = 0; i < sizeof(SMALL_PRIMES) / sizeof(SMALL_PRIMES[0]); i++) {
+		T p = SMALL_PRIMES[i];
+		if (n % p) continue;
+
+		res.push_back(std::make_pair(p, 0));
+		while (n % p == 0) n /= p, res.back().second++;
+	}
+
+	std::vector<uint64_t> primes;
+	if (n >= T(SMALL_PRIMES_BOUND)) factorize(static_cast<uint64_t>(n), primes);
+	else if (n > 1) primes.push_back(n);
+
+	std::sort(primes.begin(), primes.end());
+	for (size_t i = 0; i < primes.size(); i++) {
+		if (i == 0 || primes[i] != primes[i - 1]) res.push_back(std::make_pair(T(primes[i]), 1));
+		else res.back().second++;
+	}
+	return res;
+}
+
+// All divisors in increasing order
+template <typename T>
+inline std::vector<T> divisors(T n) {
+	std::vector< std::pair<T, int> > f = factorize(n);
+	std::vector<T> res(1, 1);
+	for (size_t i = 0; i < f.size(); i++) {
+		size_t size = res.size();
+		T p = 1;
+		for (int j = 0; j < f[i].second; j++) {
+			p *= f[i].first;
+			for (size_t k = 0; k < size; k++) res.push_back(res[k] * p);
+		}
+	}
+	std::sort(res.begin(), res.end());
+	return res;
+}
+
+template <typename T>
+inline T phi(T n) {
+	std::vector< std::pair<T, int> > f = factorize(n);
+	for (size_t i = 0; i < f.size(); i++) n = n / f[i].first * (f[i].first - 1);
+	return n;
+}
+
+// Smallest primitive root of `n`, or 0 if `n` is not 1, 2, 4, p^k or 2p^k
+template <typename T>
+inline T primitiveRoot(T n) {
+	if (n == 0) return 0;
+	if (n <= 2) return 1;
+	if (n == 4) return 3;
+
+	std::vector< std::pair<T, int> > f = factorize(n);
+	if (f[0].first == 2) {
+		if (f[0].second > 1) return 0;
+		f.erase(f.begin());
+	}
+	if (f.size() != 1) return 0;
+
+	T m = phi(n);
+	std::vector< std::pair<T, int> > g = factorize(m);
+	for (T r = 2; r < n; r++) {
+		if (gcd(r, n) != 1) continue;
+
+		bool ok = true;
+		for (size_t i = 0; i < g.size() && ok; i++) ok = pow(r, m / g[i].first, n) != 1;
+		if (ok) return r;
+	}
+	return 0;
+}
+
 }
 }
 }
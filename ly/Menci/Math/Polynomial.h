@@ -0,0 +1,459 @@
+#ifndef _LY_MENCI_MATH_POLYNOMIAL_H
+#define _LY_MENCI_MATH_POLYNOMIAL_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "ModInt.h"
+#include "NumberTheory.h"
+#include "StaticNumberTheory.h"
+
+namespace ly {
+namespace Menci {
+namespace Math {
+
+// Number theoretic transform over ModInt<P>, P must be prime since the roots of unity come from the
+// compile-time primitive root. Transforms are at most 2^RANK long, multiply splits longer products into blocks.
+// The forward transform is decimation in frequency and leaves the result in bit-reversed order,
+// the inverse is decimation in time from that order, so no bit reversal pass is ever needed.
+// Root tables are shared and grown on demand, so transforms of one P must not run concurrently.
+template <uint32_t P>
+struct NTT {
+	typedef ModInt<P> M;
+
+	static_assert(NumberTheory::Static::isPrime(P), "NTT needs a prime modulus");
+
+	const static int RANK = __builtin_ctz(P - 1);
+
+private:
+	// w[len + j] is the j-th power of the root of order 2 len, one level after another
+	// The step of each level comes from the compile-time root tables
+	static const std::vector<M> &roots(size_t n, bool inverse) {
+		static std::vector<M> w[2] = { std::vector<M>(1), std::vector<M>(1) };
+
+		// The root tables end at order 2^RANK
+		assert(fits(n));
+
+		std::vector<M> &r = w[inverse];
+		while (r.size() < n) {
+			size_t len = r.size();
+			int level = __builtin_ctzll(len) + 1;
+			M step = inverse ? NumberTheory::Static::InverseRootOfUnityTable<P>::value[level] : NumberTheory::Static::RootOfUnityTable<P>::value[level], x = 1;
+			for (size_t j = 0; j < len; j++, x *= step) r.push_back(x);
+		}
+		return r;
+	}
+
+#ifdef __AVX2__
+	// Eight Montgomery words per register, every value stays in [0, P)
+	static __m256i add(__m256i a, __m256i b) {
+		__m256i s = _mm256_add_epi32(a, b);
+		return _mm256_min_epu32(s, _mm256_sub_epi32(s, _mm256_set1_epi32(P)));
+	}
+
+	static __m256i sub(__m256i a, __m256i b) {
+		__m256i d = _mm256_sub_epi32(a, b);
+		return _mm256_min_epu32(d, _mm256_add_epi32(d, _mm256_set1_epi32(P)));
+	}
+
+	static __m256i mul(__m256i a, __m256i b) {
+		const __m256i p = _mm256_set1_epi32(P), r = _mm256_set1_epi32(M::NEG_INV);
+		__m256i even = _mm256_mul_epu32(a, b);
+		__m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+		even = _mm256_add_epi64(even, _mm256_mul_epu32(_mm256_mul_epu32(even, r), p));
+		odd = _mm256_add_epi64(odd, _mm256_mul_epu32(_mm256_mul_epu32(odd, r), p));
+		__m256i res = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xaa);
+		return _mm256_min_epu32(res, _mm256_sub_epi32(res, p));
+	}
+
+	static __m256i load(const M *a) {
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a));
+	}
+
+	static void store(M *a, __m256i x) {
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(a), x);
+	}
+#endif
+
+public:
+	static void transform(M *a, size_t n) {
+		const M *w = roots(n, false).data();
+		for (size_t len = n / 2; len >= 1; len /= 2) {
+			for (size_t i = 0; i < n; i += 2 * len) {
+				M *x = a + i, *y = a + i + len;
+				const M *r = w + len;
+				size_t j = 0;
+#ifdef __AVX2__
+				for (; j + 8 <= len; j += 8) {
+					__m256i u = load(x + j), v = load(y + j);
+					store(x + j, add(u, v));
+					store(y + j, mul(sub(u, v), load(r + j)));
+				}
+#endif
+				for (; j < len; j++) {
+					M u = x[j], v = y[j];
+					x[j] = u + v;
+					y[j] = (u - v) * r[j];
+				}
+			}
+		}
+	}
+
+	// Includes the 1 / n scale
+	static void inverseTransform(M *a, size_t n) {
+		const M *w = roots(n, true).data();
+		for (size_t len = 1; len < n; len *= 2) {
+			for (size_t i = 0; i < n; i += 2 * len) {
+				M *x = a + i, *y = a + i + len;
+				const M *r = w + len;
+				size_t j = 0;
+#ifdef __AVX2__
+				for (; j + 8 <= len; j += 8) {
+					__m256i u = load(x + j), v = mul(load(y + j), load(r + j));
+					store(x + j, add(u, v));
+					store(y + j, sub(u, v));
+				}
+#endif
+				for (; j < len; j++) {
+					M u = x[j], v = y[j] * r[j];
+					x[j] = u + v;
+					y[j] = u - v;
+				}
+			}
+		}
+
+		M k = M(n).inv();
+		for (size_t i = 0; i < n; i++) a[i] *= k;
+	}
+
+	static void pointwise(M *a, const M *b, size_t n) {
+		size_t i = 0;
+#ifdef __AVX2__
+		for (; i + 8 <= n; i += 8) store(a + i, mul(load(a + i), load(b + i)));
+#endif
+		for (; i < n; i++) a[i] *= b[i];
+	}
+
+	static bool fits(size_t n) {
+		return n <= (size_t(1) << std::min(RANK, 62));
+	}
+
+	static std::vector<M> multiply(std::vector<M> a, std::vector<M> b) {
+		if (a.empty() || b.empty()) return std::vector<M>();
+
+		size_t need = a.size() + b.size() - 1, n = 1;
+		if (std::min(a.size(), b.size()) <= 32) {
+			std::vector<M> res(need);
+			for (size_t i = 0; i < a.size(); i++) for (size_t j = 0; j < b.size(); j++) res[i + j] += a[i] * b[j];
+			return res;
+		}
+
+		// Longer than the largest transform, blocks of half its length multiply within it and are added up
+		if (!fits(need)) {
+			size_t half = size_t(1) << (std::min(RANK, 62) - 1);
+			std::vector<M> res(need);
+			for (size_t i = 0; i < a.size(); i += half) for (size_t j = 0; j < b.size(); j += half) {
+				std::vector<M> c = multiply(std::vector<M>(a.begin() + i, a.begin() + std::min(a.size(), i + half)),
+					std::vector<M>(b.begin() + j, b.begin() + std::min(b.size(), j + half)));
+				for (size_t k = 0; k < c.size(); k++) res[i + j + k] += c[k];
+			}
+			return res;
+		}
+
+		while (n < need) n *= 2;
+		a.resize(n);
+		b.resize(n);
+		transform(a.data(), n);
+		transform(b.data(), n);
+		pointwise(a.data(), b.data(), n);
+		inverseTransform(a.data(), n);
+		a.resize(need);
+		return a;
+	}
+};
+
+template <uint32_t P> const int NTT<P>::RANK;
+
+// Convolutions for any modulus and exact 64-bit ones, from three NTT primes recombined by Garner's algorithm
+struct Convolution {
+	const static uint32_t P1 = 998244353, P2 = 167772161, P3 = 469762049;
+
+private:
+	// Inputs below 2^31 are multiplied in blocks of this length, so every coefficient of a block product stays
+	// below P1 P2 P3 and its transforms within the 2^23 points P1 supports
+	enum { BLOCK = 1 << 22 };
+
+	template <uint32_t P, typename T>
+	static std::vector< ModInt<P> > lift(const T *a, size_t n) {
+		std::vector< ModInt<P> > res(n);
+		for (size_t i = 0; i < n; i++) res[i] = ModInt<P>(a[i]);
+		return res;
+	}
+
+	// Calls `f(i, x1, x2, x3)` per coefficient of a[0, n) * b[0, m), the value is x1 + x2 P1 + x3 P1 P2
+	template <typename T, typename F>
+	static void garner(const T *a, size_t n, const T *b, size_t m, F f) {
+		typedef ModInt<P2> M2;
+		typedef ModInt<P3> M3;
+
+		std::vector< ModInt<P1> > c1 = NTT<P1>::multiply(lift<P1>(a, n), lift<P1>(b, m));
+		std::vector<M2> c2 = NTT<P2>::multiply(lift<P2>(a, n), lift<P2>(b, m));
+		std::vector<M3> c3 = NTT<P3>::multiply(lift<P3>(a, n), lift<P3>(b, m));
+
+		const M2 i1 = M2(P1).inv();
+		const M3 i12 = (M3(P1) * M3(P2)).inv(), m1 = M3(P1);
+		for (size_t i = 0; i < c1.size(); i++) {
+			uint64_t x1 = c1[i].val();
+			uint64_t x2 = ((c2[i] - M2(x1)) * i1).val();
+			uint64_t x3 = ((c3[i] - M3(x1) - M3(x2) * m1) * i12).val();
+			f(i, x1, x2, x3);
+		}
+	}
+
+public:
+	// Inputs below `mod`, `mod` below 2^31
+	static std::vector<uint32_t> multiply(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b, uint32_t mod) {
+		std::vector<uint32_t> res(a.empty() || b.empty() ? 0 : a.size() + b.size() - 1);
+		const uint64_t m1 = P1 % mod, m12 = (uint64_t)P1 * P2 % mod;
+		for (size_t i = 0; i < a.size(); i += BLOCK) for (size_t j = 0; j < b.size(); j += BLOCK) {
+			garner(a.data() + i, std::min<size_t>(BLOCK, a.size() - i), b.data() + j, std::min<size_t>(BLOCK, b.size() - j),
+				[&](size_t k, uint64_t x1, uint64_t x2, uint64_t x3) {
+					uint32_t &r = res[i + j + k];
+					r = (r + (x1 + x2 * m1 + x3 * m12) % mod) % mod;
+				});
+		}
+		return res;
+	}
+
+	// Exact while every coefficient is below P1 P2 P3 ~ 7.9e25, returned modulo 2^64
+	static std::vector<uint64_t> multiply(const std::vector<uint64_t> &a, const std::vector<uint64_t> &b) {
+		std::vector<uint64_t> res(a.empty() || b.empty() ? 0 : a.size() + b.size() - 1);
+		garner(a.data(), a.size(), b.data(), b.size(), [&](size_t i, uint64_t x1, uint64_t x2, uint64_t x3) {
+			res[i] = x1 + x2 * P1 + x3 * P1 * P2;
+		});
+		return res;
+	}
+};
+
+// Complex double FFT, real convolutions are packed into one transform as a + ib
+struct FFT {
+	typedef std::complex<double> C;
+
+	static void transform(std::vector<C> &a, bool inverse) {
+		size_t n = a.size();
+		for (size_t i = 1, j = 0; i < n; i++) {
+			size_t bit = n >> 1;
+			for (; j & bit; bit >>= 1) j ^= bit;
+			j ^= bit;
+			if (i < j) std::swap(a[i], a[j]);
+		}
+
+		// Every root straight from cos / sin, so the error does not build up along a level
+		std::vector<C> w(n / 2);
+		const double PI = std::acos(-1.0);
+		for (size_t i = 0; i < n / 2; i++) w[i] = C(std::cos(2 * PI * i / n), (inverse ? -1 : 1) * std::sin(2 * PI * i / n));
+
+		for (size_t len = 1; len < n; len *= 2) {
+			for (size_t i = 0; i < n; i += 2 * len) {
+				for (size_t j = 0; j < len; j++) {
+					C u = a[i + j], v = a[i + j + len] * w[n / (2 * len) * j];
+					a[i + j] = u + v;
+					a[i + j + len] = u - v;
+				}
+			}
+		}
+
+		if (inverse) for (size_t i = 0; i < n; i++) a[i] /= n;
+	}
+
+	static std::vector<double> multiply(const std::vector<double> &a, const std::vector<double> &b) {
+		if (a.empty() || b.empty()) return std::vector<double>();
+
+		size_t need = a.size() + b.size() - 1, n = 1;
+		while (n < need) n *= 2;
+
+		std::vector<C> c(n);
+		for (size_t i = 0; i < a.size(); i++) c[i].real(a[i]);
+		for (size_t i = 0; i < b.size(); i++) c[i].imag(b[i]);
+
+		transform(c, false);
+		for (size_t i = 0; i < n; i++) c[i] *= c[i];
+		transform(c, true);
+
+		std::vector<double> res(need);
+		for (size_t i = 0; i < need; i++) res[i] = c[i].imag() / 2;
+		return res;
+	}
+
+	// Rounded, exact while the coefficients stay around 1e14 or below
+	static std::vector<long long> multiply(const std::vector<long long> &a, const std::vector<long long> &b) {
+		std::vector<double> res = multiply(std::vector<double>(a.begin(), a.end()), std::vector<double>(b.begin(), b.end()));
+		std::vector<long long> r(res.size());
+		for (size_t i = 0; i < res.size(); i++) r[i] = std::llround(res[i]);
+		return r;
+	}
+};
+
+// Any modulus through three NTT primes, so NTT<P> is never instantiated for a composite P
+template <uint32_t P>
+inline std::vector< ModInt<P> > multiply(const std::vector< ModInt<P> > &a, const std::vector< ModInt<P> > &b, std::false_type) {
+	std::vector<uint32_t> x(a.size()), y(b.size());
+	for (size_t i = 0; i < a.size(); i++) x[i] = a[i].val();
+	for (size_t i = 0; i < b.size(); i++) y[i] = b[i].val();
+
+	x = Convolution::multiply(x, y, P);
+	return std::vector< ModInt<P> >(x.begin(), x.end());
+}
+
+// A prime modulus transforms directly while the product fits its longest transform
+template <uint32_t P>
+inline std::vector< ModInt<P> > multiply(const std::vector< ModInt<P> > &a, const std::vector< ModInt<P> > &b, std::true_type) {
+	if (NTT<P>::fits(a.size() + b.size())) return NTT<P>::multiply(a, b);
+	return multiply(a, b, std::false_type());
+}
+
+template <uint32_t P>
+inline std::vector< ModInt<P> > multiply(const std::vector< ModInt<P> > &a, const std::vector< ModInt<P> > &b) {
+	return multiply(a, b, std::integral_constant<bool, NumberTheory::Static::isPrime(P)>());
+}
+
+template <int ID>
+inline std::vector< DynamicModInt<ID> > multiply(const std::vector< DynamicModInt<ID> > &a, const std::vector< DynamicModInt<ID> > &b) {
+	std::vector<uint32_t> x(a.size()), y(b.size());
+	for (size_t i = 0; i < a.size(); i++) x[i] = a[i].val();
+	for (size_t i = 0; i < b.size(); i++) y[i] = b[i].val();
+
+	x = Convolution::multiply(x, y, DynamicModInt<ID>::mod());
+	return std::vector< DynamicModInt<ID> >(x.begin(), x.end());
+}
+
+// Formal power series over a prime field, `M` is ModInt or DynamicModInt.
+// Series operations take the number of terms to keep.
+template <typename M>
+struct Polynomial : std::vector<M> {
+	using std::vector<M>::vector;
+
+	Polynomial() {}
+	Polynomial(const std::vector<M> &v) : std::vector<M>(v) {}
+
+	Polynomial truncate(size_t n) const {
+		Polynomial res(this->begin(), this->begin() + std::min(n, this->size()));
+		res.resize(n);
+		return res;
+	}
+
+	Polynomial &operator+=(const Polynomial &o) {
+		if (o.size() > this->size()) this->resize(o.size());
+		for (size_t i = 0; i < o.size(); i++) (*this)[i] += o[i];
+		return *this;
+	}
+
+	Polynomial &operator-=(const Polynomial &o) {
+		if (o.size() > this->size()) this->resize(o.size());
+		for (size_t i = 0; i < o.size(); i++) (*this)[i] -= o[i];
+		return *this;
+	}
+
+	Polynomial &operator*=(const M &k) {
+		for (size_t i = 0; i < this->size(); i++) (*this)[i] *= k;
+		return *this;
+	}
+
+	friend Polynomial operator+(Polynomial a, const Polynomial &b) { return a += b; }
+	friend Polynomial operator-(Polynomial a, const Polynomial &b) { return a -= b; }
+	friend Polynomial operator*(Polynomial a, const M &k) { return a *= k; }
+	friend Polynomial operator*(const Polynomial &a, const Polynomial &b) { return multiply(a, b); }
+
+	// Newton's iteration g = g (2 - f g), the constant term must be invertible
+	Polynomial inv(size_t n) const {
+		Polynomial g(1, (*this)[0].inv());
+		for (size_t k = 1; k < n; k *= 2) {
+			Polynomial h = (truncate(2 * k) * g).truncate(2 * k);
+			for (size_t i = 0; i < h.size(); i++) h[i] = -h[i];
+			h[0] += M(2);
+			g = (g * h).truncate(2 * k);
+		}
+		return g.truncate(n);
+	}
+
+	Polynomial derivative() const {
+		Polynomial res(this->size() ? this->size() - 1 : 0);
+		for (size_t i = 1; i < this->size(); i++) res[i - 1] = (*this)[i] * M(i);
+		return res;
+	}
+
+	Polynomial integral() const {
+		Polynomial res(this->size() + 1);
+		std::vector<M> inv(this->size() + 1, M(1));
+		for (size_t i = 2; i <= this->size(); i++) inv[i] = -M(M::mod() / i) * inv[M::mod() % i];
+		for (size_t i = 0; i < this->size(); i++) res[i + 1] = (*this)[i] * inv[i + 1];
+		return res;
+	}
+
+	// The constant term must be 1
+	Polynomial log(size_t n) const {
+		if (n == 0) return Polynomial();
+		return (truncate(n).derivative() * inv(n)).truncate(n - 1).integral();
+	}
+
+	// Newton's iteration g = g (1 - log g + f), the constant term must be 0
+	Polynomial exp(size_t n) const {
+		Polynomial g(1, M(1));
+		for (size_t k = 1; k < n; k *= 2) {
+			Polynomial h = truncate(2 * k) - g.log(2 * k);
+			h[0] += M(1);
+			g = (g * h).truncate(2 * k);
+		}
+		return g.truncate(n);
+	}
+
+	// f^k mod x^n as exp(k log f) after dividing out the lowest term, `n` must be below the modulus
+	Polynomial pow(unsigned long long k, size_t n) const {
+		size_t i = 0;
+		while (i < this->size() && (*this)[i] == M(0)) i++;
+
+		if (k == 0) return Polynomial(1, M(1)).truncate(n);
+		if (i == this->size() || (i && k >= (n + i - 1) / i)) return Polynomial(n);
+
+		size_t shift = i * k;
+		M c = (*this)[i];
+		Polynomial f(this->begin() + i, this->end());
+		f *= c.inv();
+		f = (f.log(n - shift) * M(k % M::mod())).exp(n - shift) * c.pow(k);
+
+		Polynomial res(shift);
+		res.insert(res.end(), f.begin(), f.end());
+		return res;
+	}
+
+	// Quotient of the division, the leading coefficient of `b` must be nonzero
+	friend Polynomial operator/(const Polynomial &a, const Polynomial &b) {
+		if (a.size() < b.size()) return Polynomial();
+
+		size_t n = a.size() - b.size() + 1;
+		Polynomial ra(a.rbegin(), a.rend()), rb(b.rbegin(), b.rend());
+		Polynomial q = (ra.truncate(n) * rb.inv(n)).truncate(n);
+		std::reverse(q.begin(), q.end());
+		return q;
+	}
+
+	friend Polynomial operator%(const Polynomial &a, const Polynomial &b) {
+		if (a.size() < b.size()) return a;
+		return (a - b * (a / b)).truncate(b.size() - 1);
+	}
+};
+
+}
+}
+}
+
+#endif // _LY_MENCI_MATH_POLYNOMIAL_H
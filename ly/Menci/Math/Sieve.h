@@ -0,0 +1,229 @@
+#ifndef _LY_MENCI_MATH_SIEVE_H
+#define _LY_MENCI_MATH_SIEVE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ly {
+namespace Menci {
+namespace Math {
+
+// Segmented sieve of Eratosthenes over odd numbers only, bit i stands for 2i + 1.
+// Multiples of 3, 5, 7, 11 and 13 are stamped from a precomputed wheel pattern instead of crossed off.
+struct SegmentedSieve {
+private:
+	const static uint64_t SEGMENT_BITS = 1 << 18;
+	const static uint64_t SEGMENT_WORDS = SEGMENT_BITS / 64;
+	const static uint64_t WHEEL = 3 * 5 * 7 * 11 * 13;
+	const static uint64_t BATCH = 8;
+
+	std::vector<uint64_t> pattern;
+	std::vector<uint32_t> base;
+	uint64_t limit;
+
+	// Base primes above 13 up to sqrt(r)
+	void prepare(uint64_t r) {
+		uint64_t s = std::sqrt((double)r);
+		while (s * s > r) s--;
+		while ((s + 1) * (s + 1) <= r) s++;
+		if (s <= limit) return;
+
+		std::vector<bool> composite(s + 1);
+		base.clear();
+		for (uint64_t i = 3; i <= s; i += 2) {
+			if (composite[i]) continue;
+			if (i > 13) base.push_back(i);
+			for (uint64_t j = i * i; j <= s; j += 2 * i) composite[j] = true;
+		}
+		limit = s;
+	}
+
+	void sieve(uint64_t k, uint64_t *buf) const {
+		uint64_t w = k * SEGMENT_WORDS % WHEEL;
+		for (uint64_t i = 0; i < SEGMENT_WORDS; i++) {
+			buf[i] = pattern[w];
+			if (++w == WHEEL) w = 0;
+		}
+
+		uint64_t lo = k * SEGMENT_BITS, from = 2 * lo + 1, to = 2 * (lo + SEGMENT_BITS);
+		for (size_t i = 0; i < base.size(); i++) {
+			uint64_t p = base[i], m = std::max(p * p, (from + p - 1) / p * p);
+			if (m >= to) {
+				if (p * p >= to) break;
+				continue;
+			}
+			if (!(m & 1)) m += p;
+			for (uint64_t j = (m - 1) / 2 - lo; j < SEGMENT_BITS; j += p) buf[j / 64] &= ~(1ull << (j % 64));
+		}
+
+		if (k == 0) {
+			buf[0] &= ~1ull;
+			buf[0] |= 1ull << 1 | 1ull << 2 | 1ull << 3 | 1ull << 5 | 1ull << 6;
+		}
+	}
+
+	// Calls `f` on every prime of segment `k` inside the index range [lo, hi)
+	template <typename F>
+	void scan(uint64_t k, const uint64_t *buf, uint64_t lo, uint64_t hi, F &f) const {
+		uint64_t start = k * SEGMENT_BITS;
+		for (uint64_t i = 0; i < SEGMENT_WORDS; i++) {
+			uint64_t word = buf[i], index = start + i * 64;
+			if (index + 64 <= lo) continue;
+			if (index >= hi) break;
+			while (word) {
+				uint64_t j = index + __builtin_ctzll(word);
+				word &= word - 1;
+				if (j >= lo && j < hi) f(2 * j + 1);
+			}
+		}
+	}
+
+	uint64_t popcount(const uint64_t *buf, uint64_t k, uint64_t lo, uint64_t hi) const {
+		uint64_t start = k * SEGMENT_BITS, res = 0;
+		for (uint64_t i = 0; i < SEGMENT_WORDS; i++) {
+			uint64_t word = buf[i], index = start + i * 64;
+			if (index + 64 <= lo) continue;
+			if (index >= hi) break;
+			if (index < lo) word &= ~0ull << (lo - index);
+			if (index + 64 > hi) word &= ~(~0ull << (hi - index));
+			res += __builtin_popcountll(word);
+		}
+		return res;
+	}
+
+	static unsigned threadCount(unsigned threads) {
+		return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+	}
+
+public:
+	SegmentedSieve() : pattern(WHEEL), limit(0) {
+		for (uint64_t w = 0; w < WHEEL; w++) {
+			uint64_t word = 0;
+			for (uint64_t b = 0; b < 64; b++) {
+				uint64_t x = 2 * (w * 64 + b) + 1;
+				if (x % 3 && x % 5 && x % 7 && x % 11 && x % 13) word |= 1ull << b;
+			}
+			pattern[w] = word;
+		}
+	}
+
+	// Streams the primes in [l, r) in increasing order to `f`. Segments are sieved on `threads`
+	// threads in batches (0 for the hardware concurrency), `f` always runs on the calling thread.
+	template <typename F>
+	void forEach(uint64_t l, uint64_t r, F f, unsigned threads = 1) {
+		if (l <= 2 && r > 2) f(uint64_t(2));
+		if (r <= 3) return;
+
+		prepare(r);
+		threads = threadCount(threads);
+
+		uint64_t lo = l / 2, hi = r / 2, first = lo / SEGMENT_BITS, last = (hi - 1) / SEGMENT_BITS + 1;
+		std::vector<uint64_t> buf(threads * BATCH * SEGMENT_WORDS);
+
+		for (uint64_t k = first; k < last; k += threads * BATCH) {
+			uint64_t n = std::min<uint64_t>(threads * BATCH, last - k);
+			auto work = [&](unsigned id) {
+				for (uint64_t i = id; i < n; i += threads) sieve(k + i, &buf[i * SEGMENT_WORDS]);
+			};
+
+			std::vector<std::thread> workers;
+			for (unsigned i = 1; i < threads && i < n; i++) workers.push_back(std::thread(work, i));
+			work(0);
+			for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+
+			for (uint64_t i = 0; i < n; i++) scan(k + i, &buf[i * SEGMENT_WORDS], lo, hi, f);
+		}
+	}
+
+	// Number of primes in [l, r)
+	uint64_t count(uint64_t l, uint64_t r, unsigned threads = 1) {
+		uint64_t res = l <= 2 && r > 2;
+		if (r <= 3) return res;
+
+		prepare(r);
+		threads = threadCount(threads);
+
+		uint64_t lo = l / 2, hi = r / 2, first = lo / SEGMENT_BITS, last = (hi - 1) / SEGMENT_BITS + 1;
+		std::atomic<uint64_t> next(first), total(res);
+
+		auto work = [&]() {
+			std::vector<uint64_t> buf(SEGMENT_WORDS);
+			uint64_t sum = 0;
+			for (uint64_t k; (k = next++) < last; ) {
+				sieve(k, buf.data());
+				sum += popcount(buf.data(), k, lo, hi);
+			}
+			total += sum;
+		};
+
+		std::vector<std::thread> workers;
+		for (unsigned i = 1; i < threads; i++) workers.push_back(std::thread(work));
+		work();
+		for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+
+		return total;
+	}
+
+	std::vector<uint64_t> primes(uint64_t l, uint64_t r, unsigned threads = 1) {
+		std::vector<uint64_t> res;
+		forEach(l, r, [&](uint64_t p) { res.push_back(p); }, threads);
+		return res;
+	}
+};
+
+// Linear sieve filling smallest prime factor, Euler's phi and Mobius tables for [0, n]
+struct LinearSieve {
+	enum { SPF = 1, PHI = 2, MU = 4 };
+
+	std::vector<int> primes, spf, phi;
+	std::vector<signed char> mu;
+
+	LinearSieve(int n, int tables = SPF | PHI | MU) {
+		std::vector<bool> composite(n + 1);
+		if (tables & SPF) spf.assign(n + 1, 0);
+		if (tables & PHI) phi.assign(n + 1, 0);
+		if (tables & MU) mu.assign(n + 1, 0);
+
+		if (n >= 1) {
+			if (tables & SPF) spf[1] = 1;
+			if (tables & PHI) phi[1] = 1;
+			if (tables & MU) mu[1] = 1;
+		}
+
+		for (int i = 2; i <= n; i++) {
+			if (!composite[i]) {
+				primes.push_back(i);
+				if (tables & SPF) spf[i] = i;
+				if (tables & PHI) phi[i] = i - 1;
+				if (tables & MU) mu[i] = -1;
+			}
+
+			for (size_t j = 0; j < primes.size(); j++) {
+				int p = primes[j];
+				if ((long long)p * i > n) break;
+
+				int x = p * i;
+				composite[x] = true;
+				if (tables & SPF) spf[x] = p;
+
+				if (i % p == 0) {
+					if (tables & PHI) phi[x] = phi[i] * p;
+					break;
+				}
+
+				if (tables & PHI) phi[x] = phi[i] * (p - 1);
+				if (tables & MU) mu[x] = -mu[i];
+			}
+		}
+	}
+};
+
+}
+}
+}
+
+#endif // _LY_MENCI_MATH_SIEVE_H
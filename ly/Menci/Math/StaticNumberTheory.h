@@ -0,0 +1,277 @@
+#ifndef _LY_MENCI_MATH_STATICNUMBERTHEORY_H
+#define _LY_MENCI_MATH_STATICNUMBERTHEORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "NumberTheory.h"
+
+namespace ly {
+namespace Menci {
+namespace Math {
+namespace NumberTheory {
+
+// constexpr counterparts of the runtime functions for compile-time constants and tables.
+// Everything is a single return statement as C++11 requires, and every loop is a recursion
+// whose depth is logarithmic in the value or range, far below the compiler's depth limit.
+namespace Static {
+
+template <typename T>
+constexpr T magnitude(T a, std::true_type) {
+	return a < 0 ? -a : a;
+}
+
+template <typename T>
+constexpr T magnitude(T a, std::false_type) {
+	return a;
+}
+
+// Non-negative like the runtime version
+template <typename T>
+constexpr T gcd(T a, T b) {
+	return b ? gcd(b, a % b) : magnitude(a, std::is_signed<T>());
+}
+
+template <typename T>
+constexpr T mulmod(T a, T b, T p) {
+	return static_cast<T>(static_cast<typename Wide<T>::type>(a) * b % p);
+}
+
+template <typename T>
+constexpr T pow(T a, T b, T p) {
+	return !b ? 1 % p : mulmod(pow(mulmod(a, a, p), b / 2, p), b & 1 ? a % p : 1 % p, p);
+}
+
+template <typename T>
+constexpr T submod(T a, T b, T p) {
+	return a >= b ? a - b : a + (p - b);
+}
+
+// Extended Euclid with the coefficient of `a` kept reduced modulo `p`
+template <typename T>
+constexpr T invStep(T a, T b, T x0, T x1, T p) {
+	return b ? invStep(b, a % b, x1, submod(x0, mulmod(a / b % p, x1, p), p), p) : a == 1 ? x0 : 0;
+}
+
+// 0 when `a` is not coprime to `p`
+template <typename T>
+constexpr T inv(T a, T p) {
+	return invStep(a % p, p, T(1) % p, T(0), p);
+}
+
+constexpr int trialDivide(uint64_t x, unsigned i = 0) {
+	return x < 2 ? 0
+		: i == sizeof(SMALL_PRIMES) / sizeof(SMALL_PRIMES[0]) ? (x < SMALL_PRIMES_BOUND ? 1 : -1)
+		: x == SMALL_PRIMES[i] ? 1
+		: x % SMALL_PRIMES[i] == 0 ? 0
+		: trialDivide(x, i + 1);
+}
+
+// Bases that make Miller-Rabin deterministic below 4759123141 (Jaeschke), enough for 32-bit values
+constexpr uint64_t MILLER_RABIN_BASES_32[] = { 2, 7, 61 };
+
+// Whether squaring x = a^d at most s - 1 times reaches -1, products of values below 2^32 avoid the 128-bit path
+template <typename T>
+constexpr bool reachesMinusOne(T x, int s, T n) {
+	return x == n - 1 || (s > 1 && reachesMinusOne(mulmod(x, x, n), s - 1, n));
+}
+
+template <typename T>
+constexpr bool strongProbablePrime(T n, T x, int s) {
+	return x == 1 || reachesMinusOne(x, s, n);
+}
+
+template <typename T, size_t K>
+constexpr bool millerRabin(T n, const uint64_t (&bases)[K], size_t i = 0) {
+	return i == K || ((bases[i] % n == 0 || strongProbablePrime<T>(n, pow<T>(bases[i] % n, (n - 1) >> __builtin_ctzll(n - 1), n), __builtin_ctzll(n - 1)))
+		&& millerRabin(n, bases, i + 1));
+}
+
+// Deterministic below 2^64
+template <typename T>
+constexpr bool isPrime(T x) {
+	return x < 2 ? false
+		: trialDivide(x) != -1 ? trialDivide(x) == 1
+		: uint64_t(x) >> 32 ? millerRabin<uint64_t>(x, MILLER_RABIN_BASES)
+		: millerRabin<uint32_t>(x, MILLER_RABIN_BASES_32);
+}
+
+constexpr uint32_t isqrt(uint64_t n, uint64_t lo = 0, uint64_t hi = 1ull << 32) {
+	return hi - lo == 1 ? lo : (lo + (hi - lo) / 2) * (lo + (hi - lo) / 2) <= n ? isqrt(n, lo + (hi - lo) / 2, hi) : isqrt(n, lo, lo + (hi - lo) / 2);
+}
+
+// Least divisor of `m` in [lo, hi) or 0, by halving the range so the depth stays logarithmic
+constexpr uint32_t leastDivisor(uint32_t m, uint32_t lo, uint32_t hi);
+
+constexpr uint32_t leastDivisorOr(uint32_t d, uint32_t m, uint32_t lo, uint32_t hi) {
+	return d ? d : leastDivisor(m, lo, hi);
+}
+
+constexpr uint32_t leastDivisor(uint32_t m, uint32_t lo, uint32_t hi) {
+	return hi <= lo ? 0 : hi - lo == 1 ? (m % lo ? 0 : lo) : leastDivisorOr(leastDivisor(m, lo, lo + (hi - lo) / 2), m, lo + (hi - lo) / 2, hi);
+}
+
+// Least prime factor of m > 1, given that it has none below `from`
+constexpr uint32_t leastPrimeFactor(uint32_t m, uint32_t from = 2) {
+	return leastDivisorOr(leastDivisor(m, from, isqrt(m) + 1), m, m, m + 1);
+}
+
+constexpr uint32_t strip(uint32_t m, uint32_t q) {
+	return m % q ? m : strip(m / q, q);
+}
+
+// Whether g^((p - 1) / q) != 1 for every prime factor q of the unfactored part `m` of p - 1
+constexpr bool generates(uint32_t g, uint32_t p, uint32_t m, uint32_t from = 2);
+
+constexpr bool generatesBy(uint32_t g, uint32_t p, uint32_t m, uint32_t q) {
+	return pow<uint64_t>(g, (p - 1) / q, p) != 1 && generates(g, p, strip(m, q), q + 1);
+}
+
+constexpr bool generates(uint32_t g, uint32_t p, uint32_t m, uint32_t from) {
+	return m == 1 || generatesBy(g, p, m, leastPrimeFactor(m, from));
+}
+
+// Least primitive root of the prime `p`
+constexpr uint32_t primitiveRoot(uint32_t p, uint32_t g = 2) {
+	return p == 2 ? 1 : generates(g, p, p - 1) ? g : primitiveRoot(p, g + 1);
+}
+
+template <size_t... I>
+struct IndexSequence {
+	constexpr static size_t size() {
+		return sizeof...(I);
+	}
+};
+
+template <typename A, typename B>
+struct JoinIndexSequence;
+
+template <size_t... I, size_t... J>
+struct JoinIndexSequence< IndexSequence<I...>, IndexSequence<J...> > {
+	typedef IndexSequence<I..., J...> type;
+};
+
+template <typename A, typename B>
+struct ConcatIndexSequence;
+
+template <size_t... I, size_t... J>
+struct ConcatIndexSequence< IndexSequence<I...>, IndexSequence<J...> > {
+	typedef IndexSequence<I..., sizeof...(I) + J...> type;
+};
+
+// 0, 1, ..., N - 1, built by halves so the instantiation depth is logarithmic
+template <size_t N>
+struct MakeIndexSequence : ConcatIndexSequence<typename MakeIndexSequence<N / 2>::type, typename MakeIndexSequence<N - N / 2>::type> {};
+
+template <>
+struct MakeIndexSequence<0> {
+	typedef IndexSequence<> type;
+};
+
+template <>
+struct MakeIndexSequence<1> {
+	typedef IndexSequence<0> type;
+};
+
+// Array usable in constant expressions, its elements can be template arguments
+template <typename T, size_t N>
+struct Table {
+	T a[N];
+
+	constexpr T operator[](size_t i) const {
+		return a[i];
+	}
+
+	constexpr static size_t size() {
+		return N;
+	}
+
+	const T *begin() const {
+		return a;
+	}
+
+	const T *end() const {
+		return a + N;
+	}
+};
+
+template <typename T, typename F, size_t... I>
+constexpr Table<T, sizeof...(I)> generate(IndexSequence<I...>) {
+	return {{ F::at(I)... }};
+}
+
+// value[i] = F::at(i) for i < N, `F::at` must be a constexpr static function
+template <typename T, size_t N, typename F>
+struct Generate {
+	constexpr static Table<T, N> value = generate<T, F>(typename MakeIndexSequence<N>::type());
+};
+
+template <typename T, size_t N, typename F> constexpr Table<T, N> Generate<T, N, F>::value;
+
+template <uint32_t P>
+struct InverseOf {
+	constexpr static uint32_t at(size_t i) {
+		return inv<uint64_t>(i, P);
+	}
+};
+
+// value[i] = i^-1 mod P for 0 < i < N, value[0] = 0
+template <uint32_t P, size_t N>
+struct InverseTable : Generate<uint32_t, N, InverseOf<P> > {};
+
+// Primes in [LO, HI) as a sequence, split in halves so isPrime runs exactly once per value
+template <size_t LO, size_t HI, bool LEAF = HI - LO == 1>
+struct PrimesIn : JoinIndexSequence<typename PrimesIn<LO, LO + (HI - LO) / 2>::type, typename PrimesIn<LO + (HI - LO) / 2, HI>::type> {};
+
+template <size_t LO, size_t HI>
+struct PrimesIn<LO, HI, true> {
+	typedef typename std::conditional<isPrime(LO), IndexSequence<LO>, IndexSequence<> >::type type;
+};
+
+template <typename T, size_t... I>
+constexpr Table<T, sizeof...(I)> toTable(IndexSequence<I...>) {
+	return {{ T(I)... }};
+}
+
+// The primes below N in increasing order
+template <uint32_t N>
+struct PrimeTable {
+	static_assert(N > 2, "PrimeTable needs at least one prime");
+
+	typedef typename PrimesIn<0, N>::type Sequence;
+
+	constexpr static Table<uint32_t, Sequence::size()> value = toTable<uint32_t>(Sequence());
+};
+
+template <uint32_t N> constexpr Table<uint32_t, PrimeTable<N>::Sequence::size()> PrimeTable<N>::value;
+
+template <uint32_t P>
+struct RootOfUnity {
+	constexpr static uint32_t at(size_t i) {
+		return pow<uint64_t>(primitiveRoot(P), (P - 1) >> i, P);
+	}
+};
+
+template <uint32_t P>
+struct InverseRootOfUnity {
+	constexpr static uint32_t at(size_t i) {
+		return inv<uint64_t>(RootOfUnity<P>::at(i), P);
+	}
+};
+
+// value[i] is a root of unity of order 2^i modulo the prime P, for every 2^i dividing P - 1
+template <uint32_t P>
+struct RootOfUnityTable : Generate<uint32_t, __builtin_ctz(P - 1) + 1, RootOfUnity<P> > {};
+
+template <uint32_t P>
+struct InverseRootOfUnityTable : Generate<uint32_t, __builtin_ctz(P - 1) + 1, InverseRootOfUnity<P> > {};
+
+}
+
+}
+}
+}
+}
+
+#endif // _LY_MENCI_MATH_STATICNUMBERTHEORY_H
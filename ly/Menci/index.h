@@ -3,9 +3,18 @@
 
 #include "Graph/ShortestPath.h"
 #include "Graph/NetworkFlow.h"
+#include "Graph/BipartiteMatching.h"
+#include "Graph/GomoryHu.h"
 
 #include "DataStructure/Splay.h"
+#include "DataStructure/HashTable.h"
 
+#include "Math/ModInt.h"
 #include "Math/NumberTheory.h"
+#include "Math/StaticNumberTheory.h"
+#include "Math/Sieve.h"
+#include "Math/Polynomial.h"
+#include "Math/Matrix.h"
+#include "Math/LinearRecurrence.h"
 
 #endif // _LY_MENCI_INDEX_H
@@ -10,6 +10,8 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#include "Stats.h"
+
 #define _ALLOW_FALLBACK
 #ifdef ONLINE_JUDGE
 #undef _ALLOW_FALLBACK
@@ -20,8 +22,13 @@ namespace ly
 namespace Utility
 {
 
-class InputStream
+// `S` counts buffer refills, Stats or NoStats, so TUs built with and without LY_STATS get distinct types
+template <typename S = DefaultStats>
+class BasicInputStream
 {
+public:
+    S stats;
+
 private:
 #ifdef _ALLOW_FALLBACK
     const static int BUFFER_SIZE = 1024 * 1024 * 64;
@@ -46,12 +53,14 @@ private:
         else size = fread(buf, 1, BUFFER_SIZE, stdin);
         p = buf;
         pos = 0;
+        stats.count(S::REFILLS);
     }
 #endif
 
     void map()
     {
         p = reinterpret_cast<char *>(mmap(0, size, PROT_READ, MAP_PRIVATE, fileno(stdin), 0));
+        stats.count(S::REFILLS);
     }
 
 	void init()
@@ -90,7 +99,7 @@ private:
         return p[pos++];
     }
 
-    template <typename T> InputStream &parseSigned(T &x)
+    template <typename T> BasicInputStream &parseSigned(T &x)
     {
         register char ch;
         register bool sgn = false;
@@ -107,7 +116,7 @@ private:
         return *this;
     }
 
-    template <typename T> InputStream &parseUnsigned(T &x)
+    template <typename T> BasicInputStream &parseUnsigned(T &x)
     {
         register char ch;
 
@@ -143,19 +152,19 @@ private:
         return buf;
     }
 
-    InputStream &parseFloat(float &x)
+    BasicInputStream &parseFloat(float &x)
     {
         x = strtof(floatTokenize(), nullptr);
         return *this;
     }
 
-    InputStream &parseDouble(double &x)
+    BasicInputStream &parseDouble(double &x)
     {
         x = strtod(floatTokenize(), nullptr);
         return *this;
     }
 
-    InputStream &parseLongDouble(long double &x)
+    BasicInputStream &parseLongDouble(long double &x)
     {
         x = strtold(floatTokenize(), nullptr);
         return *this;
@@ -173,47 +182,49 @@ public:
         return pos == size || p[pos] == EOF;
     }
 
-	InputStream(const char *file = nullptr) : p(nullptr)
+	BasicInputStream(const char *file = nullptr) : p(nullptr)
 	{
         if (file) freopen(file, "r", stdin);
 		init();
 	}
 
-    template <typename T> InputStream &operator>>(T &x) {
+    template <typename T> BasicInputStream &operator>>(T &x) {
         static_assert(sizeof(T) == -1, "InputStream doesn't support this type.");
         (void)x;
         return *this;
     }
 
-    InputStream &operator>>(char *s) {
+    BasicInputStream &operator>>(char *s) {
         tokenize(s);
         return *this;
     }
 
+    BasicInputStream &operator>>(int &x) { return parseSigned(x); }
+    BasicInputStream &operator>>(short &x) { return parseSigned(x); }
+    BasicInputStream &operator>>(long long &x) { return parseSigned(x); }
+    BasicInputStream &operator>>(__int128 &x) { return parseSigned(x); }
+
+    BasicInputStream &operator>>(unsigned int &x) { return parseUnsigned(x); }
+    BasicInputStream &operator>>(unsigned short &x) { return parseUnsigned(x); }
+    BasicInputStream &operator>>(unsigned long long &x) { return parseUnsigned(x); }
+    BasicInputStream &operator>>(unsigned __int128 &x) { return parseUnsigned(x); }
+
+    BasicInputStream &operator>>(float &x) { return parseFloat(x); }
+    BasicInputStream &operator>>(double &x) { return parseDouble(x); }
+    BasicInputStream &operator>>(long double &x) { return parseLongDouble(x); }
+
     operator bool() const
     {
         return !finished;
     }
 };
 
-template <> InputStream &InputStream::operator>><int>(int &x) { return parseSigned(x); }
-template <> InputStream &InputStream::operator>><short>(short &x) { return parseSigned(x); }
-template <> InputStream &InputStream::operator>><long long>(long long &x) { return parseSigned(x); }
-template <> InputStream &InputStream::operator>><__int128>(__int128 &x) { return parseSigned(x); }
-
-template <> InputStream &InputStream::operator>><unsigned int>(unsigned int &x) { return parseUnsigned(x); }
-template <> InputStream &InputStream::operator>><unsigned short>(unsigned short &x) { return parseUnsigned(x); }
-template <> InputStream &InputStream::operator>><unsigned long long>(unsigned long long &x) { return parseUnsigned(x); }
-template <> InputStream &InputStream::operator>><unsigned __int128>(unsigned __int128 &x) { return parseUnsigned(x); }
-
-template <> InputStream &InputStream::operator>><float>(float &x) { return parseFloat(x); }
-template <> InputStream &InputStream::operator>><double>(double &x) { return parseDouble(x); }
-template <> InputStream &InputStream::operator>><long double>(long double &x) { return parseLongDouble(x); }
+typedef BasicInputStream<> InputStream;
 
 }
 }
 
-std::ostream &operator<<(std::ostream &out, __int128 x)
+inline std::ostream &operator<<(std::ostream &out, __int128 x)
 {
     static char buf[128];
     register size_t s = 0;
@@ -226,7 +237,7 @@ std::ostream &operator<<(std::ostream &out, __int128 x)
     return out;
 }
 
-std::ostream &operator<<(std::ostream &out, unsigned __int128 x)
+inline std::ostream &operator<<(std::ostream &out, unsigned __int128 x)
 {
     static char buf[128];
     register size_t s = 0;
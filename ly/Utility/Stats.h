@@ -0,0 +1,157 @@
+#ifndef _LY_UTILITY_STATS_H
+#define _LY_UTILITY_STATS_H
+
+#include <cstdio>
+#include <cstring>
+
+#if !defined(__x86_64__) && !defined(__i386__)
+#include <chrono>
+#endif
+
+namespace ly
+{
+namespace Utility
+{
+
+// Events and phases shared by the instrumented algorithms. Graph algorithms reset their stats at the
+// start of every call, data structures and streams keep counting until reset() is called.
+struct StatsEvents
+{
+    enum Counter
+    {
+        RELAXATIONS,    // distance improvements
+        QUEUE_PUSHES,   // vertices put into a queue or heap
+        AUGMENTATIONS,  // augmenting paths, or blocking flow searches that carried flow
+        PHASES,         // BFS levelings, shortest path rounds or push-relabel rounds
+        PUSHES,         // push-relabel pushes
+        RELABELS,       // push-relabel global relabels
+        ROTATIONS,      // splay rotations
+        REFILLS,        // input buffer refills, a mapped file counts once
+        COUNTERS
+    };
+
+    enum Phase
+    {
+        TOTAL,
+        SEARCH,         // BFS, SPFA or Dijkstra
+        AUGMENT,        // augmentation or discharge rounds
+        RELABEL,        // global relabels
+        PHASES_COUNT
+    };
+
+    static const char *name(Counter c)
+    {
+        static const char *names[] = { "relaxations", "queue pushes", "augmentations", "phases", "pushes", "relabels", "rotations", "refills" };
+        return names[c];
+    }
+
+    static const char *name(Phase p)
+    {
+        static const char *names[] = { "total", "search", "augment", "relabel" };
+        return names[p];
+    }
+};
+
+// TSC cycles where available, nanoseconds otherwise. The builtin spares every includer the intrinsics headers.
+inline unsigned long long ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct Stats : StatsEvents
+{
+    const static bool ENABLED = true;
+
+    unsigned long long counters[COUNTERS], cycles[PHASES_COUNT];
+
+    Stats()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        memset(counters, 0, sizeof(counters));
+        memset(cycles, 0, sizeof(cycles));
+    }
+
+    void count(Counter c, unsigned long long n = 1)
+    {
+        counters[c] += n;
+    }
+
+    unsigned long long operator[](Counter c) const
+    {
+        return counters[c];
+    }
+
+    unsigned long long operator[](Phase p) const
+    {
+        return cycles[p];
+    }
+
+    // Adds the ticks between its construction and destruction to a phase
+    struct Scope
+    {
+        Stats &s;
+        Phase p;
+        unsigned long long start;
+
+        Scope(Stats &s, Phase p) : s(s), p(p), start(ticks()) {}
+
+        ~Scope()
+        {
+            s.cycles[p] += ticks() - start;
+        }
+    };
+
+    // Nonzero counters and phases, one per line
+    void print(FILE *fp = stderr) const
+    {
+        for (int i = 0; i < COUNTERS; i++) if (counters[i]) fprintf(fp, "%-16s %llu\n", name(Counter(i)), counters[i]);
+        for (int i = 0; i < PHASES_COUNT; i++) if (cycles[i]) fprintf(fp, "%-16s %llu ticks\n", name(Phase(i)), cycles[i]);
+    }
+};
+
+// The Stats interface with empty bodies, every call and Scope compiles to nothing
+struct NoStats : StatsEvents
+{
+    const static bool ENABLED = false;
+
+    void reset() {}
+
+    void count(Counter, unsigned long long = 1) {}
+
+    unsigned long long operator[](Counter) const
+    {
+        return 0;
+    }
+
+    unsigned long long operator[](Phase) const
+    {
+        return 0;
+    }
+
+    struct Scope
+    {
+        Scope(NoStats &, Phase) {}
+    };
+
+    void print(FILE * = stderr) const {}
+};
+
+// Default of every instrumented template, define LY_STATS before including ly.h to turn counting on everywhere
+#ifdef LY_STATS
+typedef Stats DefaultStats;
+#else
+typedef NoStats DefaultStats;
+#endif
+
+}
+}
+
+#endif // _LY_UTILITY_STATS_H
@@ -2,5 +2,6 @@
 #define _LY_UTILITY_INDEX_H
 
 #include "IO.h"
+#include "Stats.h"
 
 #endif // _LY_UTILITY_INDEX_H
@@ -0,0 +1,69 @@
+#include <cstdio>
+#include <cassert>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <ly.h>
+
+const int MAXN = 100;
+
+ly::Menci::Graph::NetworkFlow<MAXN> graph, fresh;
+
+// Max flow of a new graph with the current capacities, the reference for every other method
+int reference(int n, const std::vector<int> &u, const std::vector<int> &v, const std::vector<int> &c) {
+	fresh.clear();
+	for (size_t i = 0; i < u.size(); i++) fresh.addEdge(u[i], v[i], c[i]);
+	return fresh.dinic(0, n - 1, n);
+}
+
+int main() {
+	int rounds, n, m, q;
+	scanf("%d %d %d %d", &rounds, &n, &m, &q);
+
+	std::mt19937 rng(rounds);
+	long long total = 0;
+	for (int r = 0; r < rounds; r++) {
+		std::vector<int> u(m), v(m), c(m), id(m);
+		graph.clear();
+		for (int i = 0; i < m; i++) {
+			u[i] = rng() % n, v[i] = rng() % n, c[i] = rng() % 20;
+			id[i] = graph.addEdge(u[i], v[i], c[i]);
+		}
+
+		int s = 0, t = n - 1, flow = graph.dinic(s, t, n);
+		assert(flow == reference(n, u, v, c));
+
+		// Explicit thread counts, so the parallel rounds run even where the hardware has a single core
+		graph.resetFlow();
+		assert(graph.pushrelabel(s, t, n, 1) == flow);
+		graph.resetFlow();
+		assert(graph.pushrelabel(s, t, n, 4) == flow);
+
+		for (int k = 0; k < q; k++) {
+			int i = rng() % m, delta = rng() % 10;
+			if (rng() % 2) {
+				graph.increaseCapacity(id[i], delta);
+				c[i] += delta;
+				flow += graph.dinic(s, t, n);
+			} else {
+				// Oversized decreases are clamped to the current capacity, and the flow left is already maximum
+				flow -= graph.decreaseCapacity(id[i], delta, s, t, n);
+				c[i] -= std::min(delta, c[i]);
+			}
+			assert(flow == reference(n, u, v, c));
+		}
+
+		std::vector<int> side, cut;
+		graph.minCut(s, n, side, cut);
+		int capacity = 0;
+		for (size_t i = 0; i < cut.size(); i++) capacity += graph.getCapacity(cut[i]);
+		assert(capacity == flow);
+		assert(side[0] == s && std::find(side.begin(), side.end(), t) == side.end());
+
+		total += flow;
+	}
+
+	printf("%lld\n", total);
+
+	return 0;
+}
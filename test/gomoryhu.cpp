@@ -0,0 +1,41 @@
+#include <cstdio>
+#include <cassert>
+#include <random>
+#include <ly.h>
+
+const int MAXN = 60;
+
+ly::Menci::Graph::GomoryHu<MAXN> tree;
+ly::Menci::Graph::NetworkFlow<MAXN> fresh;
+
+int main() {
+	int rounds, n, m;
+	scanf("%d %d %d", &rounds, &n, &m);
+
+	std::mt19937 rng(rounds);
+	long long total = 0;
+	for (int r = 0; r < rounds; r++) {
+		tree.clear();
+		fresh.clear();
+		for (int i = 0; i < m; i++) {
+			int u = rng() % n, v = rng() % n, c = rng() % 20;
+			tree.addEdge(u, v, c);
+			fresh.addEdge(u, v, c), fresh.addEdge(v, u, c);
+		}
+
+		// Every pair against a plain max flow, with sequential and parallel flows inside the tree
+		for (unsigned threads = 1; threads <= 4; threads += 3) {
+			tree.build(n, threads);
+			for (int s = 0; s < n; s++) for (int t = s + 1; t < n; t++) {
+				fresh.resetFlow();
+				int flow = fresh.dinic(s, t, n);
+				assert(tree.minCut(s, t) == flow && tree.minCut(t, s) == flow);
+				total += flow;
+			}
+		}
+	}
+
+	printf("%lld\n", total);
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+#include <cstdio>
+#include <cassert>
+#include <ly.h>
+
+const int MAXN = 500;
+
+ly::Menci::Graph::BipartiteMatching<MAXN + 1> matching;
+ly::Menci::Graph::NetworkFlow<MAXN * 2 + 3> graph;
+
+int main() {
+	int n, m, e;
+	scanf("%d %d %d", &n, &m, &e);
+
+	int s = 0, t = n + m + 1;
+	for (int i = 1; i <= n; i++) graph.addEdge(s, i, 1);
+	for (int i = 1; i <= m; i++) graph.addEdge(n + i, t, 1);
+
+	while (e--) {
+		int u, v;
+		scanf("%d %d", &u, &v);
+
+		matching.addEdge(u, v);
+		graph.addEdge(u, n + v, 1);
+	}
+
+	int ans = matching.hopcroftkarp(n + 1, m + 1);
+	assert(ans == graph.dinic(s, t, t + 1));
+
+	std::vector<int> left, right;
+	matching.vertexCover(left, right);
+	assert(int(left.size() + right.size()) == ans);
+
+	printf("%d\n", ans);
+
+	return 0;
+}
@@ -0,0 +1,71 @@
+#include <cstdio>
+#include <cassert>
+#include <random>
+#include <vector>
+#include <ly.h>
+
+using namespace ly::Menci::Math;
+
+typedef ModInt<998244353> M;
+
+std::mt19937 rng;
+
+template <typename T>
+std::vector<T> random(size_t n) {
+	std::vector<T> res(n);
+	for (size_t i = 0; i < n; i++) res[i] = T((long long)(rng() % 2147483647));
+	return res;
+}
+
+template <typename T>
+std::vector<T> naive(const std::vector<T> &a, const std::vector<T> &b) {
+	std::vector<T> res(a.empty() || b.empty() ? 0 : a.size() + b.size() - 1);
+	for (size_t i = 0; i < a.size(); i++) for (size_t j = 0; j < b.size(); j++) res[i + j] += a[i] * b[j];
+	return res;
+}
+
+// Products of every size up to `n`, also for sizes past the longest transform of P
+template <uint32_t P>
+void checkMultiply(size_t n) {
+	std::vector< ModInt<P> > a = random< ModInt<P> >(rng() % n + 1), b = random< ModInt<P> >(rng() % n + 1);
+	assert(multiply(a, b) == naive(a, b));
+}
+
+int main() {
+	int rounds, n;
+	scanf("%d %d", &rounds, &n);
+
+	rng.seed(rounds);
+	for (int r = 0; r < rounds; r++) {
+		checkMultiply<998244353>(n);
+		// 12289 - 1 = 3 * 2^12, so longer products are split into blocks or go through Convolution
+		checkMultiply<12289>(n);
+		// 10^9 + 7 has no large power of two in P - 1, and 10^9 + 1 is not even prime
+		checkMultiply<1000000007>(n);
+		checkMultiply<1000000001>(n);
+
+		std::vector< ModInt<12289> > a = random< ModInt<12289> >(rng() % n + 1), b = random< ModInt<12289> >(rng() % n + 1);
+		assert(NTT<12289>::multiply(a, b) == naive(a, b));
+
+		DynamicModInt<>::setMod(rng() % 1000000000 + 2);
+		std::vector< DynamicModInt<> > x = random< DynamicModInt<> >(rng() % n + 1), y = random< DynamicModInt<> >(rng() % n + 1);
+		assert(multiply(x, y) == naive(x, y));
+
+		size_t k = rng() % n + 1;
+		Polynomial<M> f = random<M>(k);
+		if (f[0] == M(0)) f[0] = M(1);
+
+		Polynomial<M> g = f.inv(k), one = (f * g).truncate(k);
+		assert(one[0] == M(1));
+		for (size_t i = 1; i < k; i++) assert(one[i] == M(0));
+
+		f[0] = M(1);
+		assert(f.log(k).exp(k) == f);
+		f[0] = M(0);
+		assert(f.exp(k).log(k) == f);
+	}
+
+	puts("ok");
+
+	return 0;
+}